@@ -8,26 +8,47 @@
 #include <QPushButton>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QStack>
+#include <QPixmap>
+#include <QResizeEvent>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QThread>
+#include <QPointer>
+#include <QTimer>
+#include <QComboBox>
+#include <QLabel>
+#include <QMenu>
 
-// Clase que representa un punto en el grafo
-class Punto {
-public:
-    QPointF posicion; // Posición del punto en el espacio 2D
-    QList<Punto*> conexiones; // Lista de punteros a otros puntos conectados
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
 
-    // Constructor que inicializa la posición del punto
-    Punto(QPointF pos) : posicion(pos) {}
-
-    // Método para conectar este punto con otro
-    void conectarCon(Punto* otro) {
-        // Verifica si la conexión ya existe
-        if (!conexiones.contains(otro)) {
-            conexiones.append(otro); // Agrega el otro punto a las conexiones
-            otro->conexiones.append(this); // Conexión bidireccional
-        }
-    }
-};
+#include "algoritmos.h"
+#include "arbolminimo.h"
+#include "autoconexion.h"
+#include "caminos.h"
+#include "cliques.h"
+#include "coloreo.h"
+#include "conectividad.h"
+#include "disposicion.h"
+#include "formatobinario.h"
+#include "formatotexto.h"
+#include "grafo.h"
+#include "historial.h"
+#include "importador.h"
+#include "matrizdistancias.h"
+#include "indiceespacial.h"
+#include "modolote.h"
+#include "poolhilos.h"
 
 // Clase principal que representa el widget donde se dibuja el grafo
 class MiWidget : public QWidget {
@@ -35,26 +56,98 @@ class MiWidget : public QWidget {
 
 public:
     // Constructor del widget
-    MiWidget(QWidget *padre = nullptr) : QWidget(padre) {
-        setWindowTitle("Programa Representación de Grafos"); // Título de la ventana
+    MiWidget(QWidget *padre = nullptr) : QWidget(padre), disposicion(hilos) {
+        setWindowTitle(tituloVentana); // Título de la ventana
         resize(800, 600); // Tamaño inicial de la ventana
 
-        // Crear botones para deshacer y borrar
-        QPushButton *botonDeshacer = new QPushButton("Deshacer", this);
+        // Crear botones para deshacer, rehacer, borrar, abrir, guardar, importar, distribuir, buscar caminos,
+        // mostrar el árbol mínimo, exportar distancias, conectar los puntos automáticamente y buscar conjuntos
+        botonDeshacer = new QPushButton("Deshacer", this);
+        botonRehacer = new QPushButton("Rehacer", this);
         QPushButton *botonBorrar = new QPushButton("Borrar Todo", this);
+        QPushButton *botonAbrir = new QPushButton("Abrir", this);
+        QPushButton *botonGuardar = new QPushButton("Guardar", this);
+        QPushButton *botonImportar = new QPushButton("Importar", this);
+        botonDistribuir = new QPushButton("Distribuir", this);
+        QPushButton *botonCamino = new QPushButton("Camino", this);
+        botonCamino->setCheckable(true); // Mientras está activo se muestra el camino entre los seleccionados
+        QPushButton *botonArbol = new QPushButton("Árbol", this);
+        botonArbol->setCheckable(true); // Mientras está activo se resalta el árbol de expansión mínima
+        botonDistancias = new QPushButton("Distancias", this);
+        QPushButton *botonAutoconectar = new QPushButton("Autoconectar", this);
+        QMenu *menuAutoconectar = new QMenu(botonAutoconectar); // Cada forma de conectar es una opción del menú
+        menuAutoconectar->addAction("Triangulación de Delaunay", [this] { autoconectar(Autoconexion::Delaunay); });
+        menuAutoconectar->addAction("Árbol euclidiano", [this] { autoconectar(Autoconexion::ArbolEuclidiano); });
+        menuAutoconectar->addAction(QString("%1 vecinos más cercanos").arg(vecinosAutoconexion),
+                                    [this] { autoconectar(Autoconexion::Vecinos); });
+        botonAutoconectar->setMenu(menuAutoconectar);
+        botonConjuntos = new QPushButton("Buscar", this);
+        QMenu *menuConjuntos = new QMenu(botonConjuntos); // El resultado queda seleccionado
+        menuConjuntos->addAction("Clique máxima", [this] { seleccionarConjunto(true); });
+        menuConjuntos->addAction("Conjunto independiente máximo", [this] { seleccionarConjunto(false); });
+        botonConjuntos->setMenu(menuConjuntos);
 
         // Establecer un tamaño fijo para los botones
         botonDeshacer->setFixedSize(80, 30); // Ancho 80, Alto 30
+        botonRehacer->setFixedSize(80, 30); // Ancho 80, Alto 30
         botonBorrar->setFixedSize(80, 30); // Ancho 80, Alto 30
+        botonAbrir->setFixedSize(80, 30); // Ancho 80, Alto 30
+        botonGuardar->setFixedSize(80, 30); // Ancho 80, Alto 30
+        botonImportar->setFixedSize(80, 30); // Ancho 80, Alto 30
+        botonDistribuir->setFixedSize(80, 30); // Ancho 80, Alto 30
+        botonCamino->setFixedSize(80, 30); // Ancho 80, Alto 30
+        botonArbol->setFixedSize(80, 30); // Ancho 80, Alto 30
+        botonDistancias->setFixedSize(80, 30); // Ancho 80, Alto 30
+        botonAutoconectar->setFixedSize(100, 30); // Más ancho: el texto y la flecha del menú no caben en 80
+        botonConjuntos->setFixedSize(80, 30); // Ancho 80, Alto 30
 
         // Conectar señales de los botones a los slots correspondientes
         connect(botonDeshacer, &QPushButton::clicked, this, &MiWidget::deshacer);
+        connect(botonRehacer, &QPushButton::clicked, this, &MiWidget::rehacer);
         connect(botonBorrar, &QPushButton::clicked, this, &MiWidget::borrar);
+        connect(botonAbrir, &QPushButton::clicked, this, &MiWidget::abrir);
+        connect(botonGuardar, &QPushButton::clicked, this, &MiWidget::guardar);
+        connect(botonImportar, &QPushButton::clicked, this, &MiWidget::importar);
+        connect(botonDistribuir, &QPushButton::clicked, this, &MiWidget::distribuir);
+        connect(botonCamino, &QPushButton::toggled, this, &MiWidget::mostrarCaminos);
+        connect(botonArbol, &QPushButton::toggled, this, &MiWidget::mostrarArbol);
+        connect(botonDistancias, &QPushButton::clicked, this, &MiWidget::exportarDistancias);
+        connect(&temporizadorDistribucion, &QTimer::timeout, this, &MiWidget::pasoDistribucion);
+        temporizadorDistribucion.setInterval(16); // Un paso por cuadro
 
         // Layout horizontal para los botones
         QHBoxLayout *layoutBotones = new QHBoxLayout();
         layoutBotones->addWidget(botonDeshacer); // Agregar botón de deshacer
+        layoutBotones->addWidget(botonRehacer); // Agregar botón de rehacer
         layoutBotones->addWidget(botonBorrar); // Agregar botón de borrar
+        layoutBotones->addWidget(botonAbrir); // Agregar botón de abrir
+        layoutBotones->addWidget(botonGuardar); // Agregar botón de guardar
+        layoutBotones->addWidget(botonImportar); // Agregar botón de importar
+        layoutBotones->addWidget(botonDistribuir); // Agregar botón de distribuir
+        layoutBotones->addWidget(botonCamino); // Agregar botón de camino
+        layoutBotones->addWidget(botonArbol); // Agregar botón de árbol
+        layoutBotones->addWidget(botonDistancias); // Agregar botón de distancias
+        layoutBotones->addWidget(botonAutoconectar); // Agregar botón de autoconexión
+        layoutBotones->addWidget(botonConjuntos); // Agregar botón de búsqueda de conjuntos
+
+        // Selector del recorrido que se muestra con colores; el origen es el primer punto seleccionado
+        QComboBox *selectorRecorrido = new QComboBox(this);
+        selectorRecorrido->addItem("Sin recorrido");
+        selectorRecorrido->addItem("Anchura (BFS)");
+        selectorRecorrido->addItem("Profundidad (DFS)");
+        selectorRecorrido->addItem("Componentes");
+        selectorRecorrido->addItem("Coloreo voraz");
+        selectorRecorrido->addItem("Coloreo DSatur");
+        selectorRecorrido->addItem("Coloreo paralelo");
+        connect(selectorRecorrido, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MiWidget::cambiarRecorrido);
+        layoutBotones->addWidget(selectorRecorrido); // Agregar el selector de recorrido
+
+        // Cantidad de componentes y, con dos puntos seleccionados, si están conectados
+        etiquetaConectividad = new QLabel(this);
+        layoutBotones->addWidget(etiquetaConectividad); // Agregar la etiqueta de conectividad
+        mostrarConectividad();
+        botones = {botonDeshacer, botonRehacer, botonBorrar, botonAbrir, botonGuardar, botonImportar, botonDistribuir, botonCamino, botonArbol, botonDistancias, botonAutoconectar, botonConjuntos};
+        actualizarBotonesHistorial(); // Al empezar no hay nada que deshacer
 
         // Layout principal vertical
         QVBoxLayout *layoutPrincipal = new QVBoxLayout(this);
@@ -66,39 +159,114 @@ public:
         setLayout(layoutPrincipal); // Establecer el layout principal
     }
 
+    // Destructor: una importación o exportación en curso se cancela y se espera
+    // a que su hilo termine; una búsqueda termina sola al agotar su límite
+    ~MiWidget() override {
+        if (hiloImportacion) {
+            cancelarImportacion = true;
+            hiloImportacion->wait();
+        }
+        if (hiloMatriz) {
+            cancelarMatriz = true;
+            hiloMatriz->wait();
+        }
+        if (hiloBusqueda) {
+            hiloBusqueda->wait();
+        }
+    }
+
+    // Cambia la memoria máxima del historial de deshacer y rehacer (64 MiB por defecto)
+    void setLimiteHistorial(size_t bytes) {
+        historial.setLimiteBytes(bytes);
+        conectividad.descartarPasos(historial.tomarDescartados());
+        actualizarBotonesHistorial();
+    }
+
 protected:
     // Método que se llama para dibujar el widget
     void paintEvent(QPaintEvent *evento) override {
+        // Si el grafo o el origen cambiaron, el recorrido se recalcula y la capa se pinta entera con los colores nuevos
+        if (recorridoDesactualizado()) {
+            calcularRecorrido();
+            capaValida = false;
+            if (evento->rect() != rect()) {
+                update(); // Los colores pueden cambiar fuera de la región expuesta
+            }
+        }
+        if (arbolActivo && (!arbolVigente || versionArbol != grafo.version())) {
+            calcularArbol();
+            if (evento->rect() != rect()) {
+                update(); // El árbol cubre todo el grafo
+            }
+        }
+        if (caminoDesactualizado()) {
+            calcularCamino();
+            if (evento->rect() != rect()) {
+                update(); // El camino anterior y el nuevo pueden pasar por cualquier parte
+            }
+        }
+
+        // La capa con el grafo sin selección se reconstruye entera solo si se invalidó o cambió de tamaño
+        if (!capaValida || capa.size() != size() * devicePixelRatioF()) {
+            reconstruirCapa();
+        }
+
         QPainter pintor(this); // Crear un objeto QPainter para dibujar
-        pintor.setPen(Qt::black); // Establecer el color del lápiz a negro
+        const QRect expuesto = evento->rect();
+        pintor.setClipRect(expuesto); // Solo se copia la región expuesta
+        pintor.drawPixmap(0, 0, capa); // Copia la capa estática ya dibujada
 
-        // Dibuja los puntos
-        for (Punto* punto : puntos) {
-            if (puntosSeleccionados.contains(punto)) {
-                pintor.setBrush(Qt::red); // Color para puntos seleccionados
-            } else {
-                pintor.setBrush(Qt::black); // Color para puntos no seleccionados
+        // Superpone el árbol de expansión mínima desde su propia capa, que se dibuja
+        // entera solo cuando cambia el árbol; un redibujo parcial no recorre sus aristas
+        if (arbolActivo) {
+            if (!capaArbolValida || capaArbol.size() != capa.size()) {
+                reconstruirCapaArbol();
             }
-            pintor.drawEllipse(punto->posicion, 7, 7); // Dibuja un círculo de radio 7
+            pintor.drawPixmap(0, 0, capaArbol);
         }
 
-        // Dibuja líneas entre los puntos conectados
-        pintor.setPen(Qt::black); // Cambia el color para las líneas de conexión
-        for (Punto* punto : puntos) {
-            for (Punto* puntoConectado : punto->conexiones) {
-                pintor.drawLine(punto->posicion, puntoConectado->posicion); // Dibuja una línea entre puntos conectados
+        // Superpone el camino más corto entre los puntos seleccionados, si se pidió
+        if (caminoActivo && verticesCamino.size() >= 2) {
+            lineas.clear();
+            for (size_t i = 1; i < verticesCamino.size(); ++i) {
+                lineas.append(QLineF(posicion(verticesCamino[i - 1]), posicion(verticesCamino[i])));
+            }
+            pintor.setPen(QPen(QColor(30, 110, 230), 4));
+            pintor.drawLines(lineas);
+        }
+
+        // Superpone los puntos seleccionados que caen en la región expuesta
+        const double margen = radioPunto + 1;
+        const QRectF areaPuntos = QRectF(expuesto).adjusted(-margen, -margen, margen, margen);
+        pintor.setPen(Qt::black); // Establecer el color del lápiz a negro
+        pintor.setBrush(Qt::red); // Color para puntos seleccionados
+        for (int punto : puntosSeleccionados) {
+            if (areaPuntos.contains(posicion(punto))) {
+                pintor.drawEllipse(posicion(punto), radioPunto, radioPunto);
             }
         }
     }
 
+    // Método que se llama cuando cambia el tamaño del widget
+    void resizeEvent(QResizeEvent *evento) override {
+        QWidget::resizeEvent(evento);
+        capaValida = false; // La capa se vuelve a crear con el nuevo tamaño en el próximo dibujo
+    }
+
     // Método que se llama cuando se presiona un botón del mouse
     void mousePressEvent(QMouseEvent *evento) override {
+        if (importando) {
+            return; // Los ids del grafo los asigna la importación hasta que termine
+        }
         if (evento->button() == Qt::LeftButton) {
-            // Agrega la posición del clic a la lista de puntos
-            Punto* nuevoPunto = new Punto(evento->pos()); // Crear un nuevo punto en la posición del clic
-            puntos.append(nuevoPunto); // Agregar el nuevo punto a la lista de puntos
-            acciones.push_back({TipoAccion::Agregar, nuevoPunto}); // Guardar la acción de agregar
-            update(); // Solicita una actualización de la ventana para redibujar
+            // Agrega la posición del clic al grafo
+            int nuevoPunto = grafo.agregarVertice(evento->pos().x(), evento->pos().y()); // Crear un nuevo punto en la posición del clic
+            indice.insertar(nuevoPunto, grafo.x(nuevoPunto), grafo.y(nuevoPunto)); // Registrar el punto en el índice espacial
+            registrarAccion(Historial::agregarVertice(grafo.x(nuevoPunto), grafo.y(nuevoPunto))); // Guardar la acción de agregar
+            conectividad.agregarVertice();
+            mostrarConectividad();
+            actualizarCapa(rectPunto(nuevoPunto)); // Agregar el círculo a la capa estática
+            update(rectPunto(nuevoPunto)); // Solo se redibuja el círculo nuevo
         } else if (evento->button() == Qt::RightButton) {
             // Conectar el punto seleccionado al hacer clic derecho
             seleccionarPunto(evento->pos()); // Seleccionar el punto en la posición del clic
@@ -111,98 +279,844 @@ private slots:
     void conectarPuntos() {
         // Solo conectar si hay al menos dos puntos seleccionados
         if (puntosSeleccionados.size() >= 2) {
-            for (int i = 0; i < puntosSeleccionados.size(); ++i) {
-                for (int j = i + 1; j < puntosSeleccionados.size(); ++j) {
-                    // Conectar los puntos seleccionados
-                    puntosSeleccionados[i]->conectarCon(puntosSeleccionados[j]);
-                    // Guardar la acción de conexión
-                    acciones.push_back({TipoAccion::Conectar, puntosSeleccionados[i], puntosSeleccionados[j]});
-                }
+            QRect afectado; // Une los círculos seleccionados y las aristas nuevas
+            for (int punto : puntosSeleccionados) {
+                afectado |= rectPunto(punto); // Deja de estar seleccionado
             }
+
+            // Conecta toda la selección en una pasada y guarda un solo registro compacto para deshacer
+            const std::vector<int> seleccion(puntosSeleccionados.begin(), puntosSeleccionados.end());
+            Grafo::LoteAristas lote = grafo.conectarTodos(seleccion);
             puntosSeleccionados.clear(); // Limpiar la selección después de conectar
-            update(); // Solicita una actualización de la ventana para redibujar
+            if (!lote.vertices.empty()) {
+                afectado |= rectLote(lote); // Aristas nuevas, que se agregan a la capa estática
+                if (capaValida) {
+                    // Las líneas van encima de todo, así que basta con dibujarlas sobre la capa
+                    QPainter pintorCapa(&capa);
+                    pintorCapa.setPen(Qt::black);
+                    pintorCapa.drawLines(lineas);
+                }
+                registrarAccion(Historial::conectarLote(seleccion, lote)); // Guardar la acción de conexión
+                conectividad.unirLote(grafo, lote); // Solo se unen las componentes de las aristas nuevas
+            }
+            mostrarConectividad();
+            update(afectado); // Solo se redibuja la zona que cambió
         }
     }
 
-    // Método para deshacer la última acción
+    // Método para deshacer la última acción (o el último grupo de acciones)
     void deshacer() {
-        if (!acciones.isEmpty()) {
-            Accion ultimaAccion = acciones.pop(); // Obtener la última acción
+        QRect afectado; // Zona a redibujar, calculada antes de modificar el grafo
+        historial.deshacer([&](Historial::Comando &comando) {
+            if (comando.tipo == Historial::TipoComando::AgregarVertice) {
+                // Eliminar el último punto agregado (siempre es el de mayor id)
+                const int punto = grafo.cantidadVertices() - 1;
+                afectado |= rectPunto(punto);
+                indice.eliminar(punto, grafo.x(punto), grafo.y(punto)); // Quitarlo del índice espacial
+                puntosSeleccionados.removeAll(punto); // Que no quede seleccionado un punto inexistente
+                grafo.eliminarUltimoVertice(); // Remover el punto del grafo
+            } else {
+                // Deshacer todas las conexiones del lote
+                const Grafo::LoteAristas lote = Historial::loteDe(comando);
+                afectado |= rectLote(lote);
+                grafo.deshacerLote(lote);
+            }
+            conectividad.deshacerPaso(); // Revierte las uniones de este comando, sin recorrer el grafo
+        });
+        actualizarBotonesHistorial();
+        mostrarConectividad();
+        if (!afectado.isNull()) {
+            actualizarCapa(afectado); // Borrar lo quitado de la capa estática
+            update(afectado); // Solo se redibuja la zona que cambió
+        }
+    }
 
-            if (ultimaAccion.tipo == TipoAccion::Agregar) {
-                // Eliminar el último punto agregado
-                puntos.removeOne(ultimaAccion.punto); // Remover el punto de la lista
-                delete ultimaAccion.punto; // Liberar memoria del punto eliminado
-            } else if (ultimaAccion.tipo == TipoAccion::Conectar) {
-                // Deshacer la conexión
-                ultimaAccion.punto->conexiones.removeOne(ultimaAccion.puntoConectado); // Remover la conexión
-                ultimaAccion.puntoConectado->conexiones.removeOne(ultimaAccion.punto); // Remover la conexión en la otra dirección
+    // Método para rehacer la última acción deshecha
+    void rehacer() {
+        QRect afectado; // Zona a redibujar, calculada después de modificar el grafo
+        historial.rehacer([&](Historial::Comando &comando) {
+            if (comando.tipo == Historial::TipoComando::AgregarVertice) {
+                // Vuelve a recibir el mismo id, porque se deshizo siendo el último
+                const int punto = grafo.agregarVertice(comando.x, comando.y);
+                indice.insertar(punto, comando.x, comando.y);
+                afectado |= rectPunto(punto);
+                conectividad.abrirPaso();
+                conectividad.agregarVertice();
+            } else if (comando.tipo == Historial::TipoComando::ConectarLote) {
+                // Se reconecta la misma selección; el lote nuevo reemplaza al guardado
+                const Grafo::LoteAristas lote = grafo.conectarTodos(Historial::verticesDe(comando));
+                Historial::actualizarLote(comando, lote);
+                afectado |= rectLote(lote);
+                conectividad.abrirPaso();
+                conectividad.unirLote(grafo, lote);
+            } else {
+                // Las aristas guardadas son justo las que faltan, así que el lote es el mismo de antes
+                std::vector<int> pares = comando.datos;
+                const Grafo::LoteAristas lote = grafo.conectarAristas(pares);
+                afectado |= rectLote(lote);
+                conectividad.abrirPaso();
+                conectividad.unirLote(grafo, lote);
             }
-            update(); // Solicita una actualización de la ventana para redibujar
+        });
+        conectividad.descartarPasos(historial.tomarDescartados()); // Rehacer también puede pasar del límite
+        actualizarBotonesHistorial();
+        mostrarConectividad();
+        if (!afectado.isNull()) {
+            actualizarCapa(afectado); // Dibujar lo rehecho en la capa estática
+            update(afectado); // Solo se redibuja la zona que cambió
         }
     }
 
     // Método para borrar todos los puntos y conexiones
     void borrar() {
         // Limpiar todos los puntos y conexiones
-        qDeleteAll(puntos); // Eliminar todos los puntos de la memoria
-        puntos.clear(); // Limpiar la lista de puntos
+        grafo.limpiar(); // Eliminar todos los puntos y sus conexiones
+        indice.limpiar(); // Vaciar el índice espacial
         puntosSeleccionados.clear(); // Limpiar la lista de puntos seleccionados
-        acciones.clear(); // Limpiar la pila de acciones
+        historial.limpiar(); // Limpiar el historial de deshacer y rehacer
+        conectividad.limpiar(); // Sin vértices no hay componentes
+        actualizarBotonesHistorial();
+        mostrarConectividad();
+        capaValida = false; // La capa estática se vuelve a crear vacía
         update(); // Solicita una actualización de la ventana para redibujar
     }
 
+    // Método para cargar un grafo desde un archivo binario (.grafo) o de texto (.graph)
+    void abrir() {
+        const QString ruta = QFileDialog::getOpenFileName(this, "Abrir grafo", QString(), "Grafos (*.grafo *.graph)");
+        if (ruta.isEmpty()) {
+            return;
+        }
+
+        borrar(); // El grafo cargado reemplaza al actual y no se puede deshacer
+        const std::string rutaLocal = ruta.toLocal8Bit().toStdString();
+        std::string error;
+        bool cargado = false;
+        if (ArchivoGrafoBinario::esBinario(rutaLocal)) {
+            // El archivo se mapea en memoria y se copia de una vez, sin interpretar texto
+            ArchivoGrafoBinario archivo;
+            cargado = archivo.abrir(rutaLocal, error);
+            if (cargado) {
+                archivo.copiarEn(grafo);
+            }
+        } else {
+            std::ifstream entrada(rutaLocal);
+            cargado = entrada && cargarGrafoTexto(entrada, grafo, error);
+            if (!entrada && error.empty()) {
+                error = "no se pudo abrir el archivo";
+            }
+        }
+        if (!cargado) {
+            grafo.limpiar(); // No se deja un grafo cargado a medias
+            QMessageBox::warning(this, "Abrir grafo", QString::fromStdString(error));
+            return;
+        }
+
+        for (int v = 0; v < grafo.cantidadVertices(); ++v) {
+            indice.insertar(v, grafo.x(v), grafo.y(v)); // Registrar cada punto en el índice espacial
+        }
+        conectividad.reconstruir(grafo); // Una sola pasada por el grafo cargado
+        mostrarConectividad();
+        capaValida = false; // La capa se dibuja completa con el grafo nuevo
+        update();
+    }
+
+    // Método para guardar el grafo en el formato binario (.grafo) o de texto (.graph), según la extensión
+    void guardar() {
+        const QString ruta = QFileDialog::getSaveFileName(this, "Guardar grafo", QString(), "Grafos (*.grafo);;Texto (*.graph)");
+        if (ruta.isEmpty()) {
+            return;
+        }
+        const std::string rutaLocal = ruta.toLocal8Bit().toStdString();
+        std::string error;
+        bool guardado = false;
+        if (ruta.endsWith(".graph", Qt::CaseInsensitive)) {
+            std::ofstream salida(rutaLocal);
+            guardado = salida && guardarGrafoTexto(salida, grafo);
+            if (!guardado) {
+                error = "no se pudo escribir el archivo";
+            }
+        } else {
+            guardado = guardarGrafoBinario(rutaLocal, grafo, error);
+        }
+        if (!guardado) {
+            QMessageBox::warning(this, "Guardar grafo", QString::fromStdString(error));
+        }
+    }
+
+    // Método para importar una lista de aristas, DIMACS o GraphML sin bloquear la
+    // ventana: un hilo lee el archivo por bloques y entrega lotes que se agregan
+    // al grafo y se dibujan a medida que llegan
+    void importar() {
+        const QString ruta = QFileDialog::getOpenFileName(
+            this, "Importar grafo", QString(),
+            "Listas de aristas (*.txt *.edges *.el *.tsv *.csv);;DIMACS (*.col *.dimacs *.gr);;GraphML (*.graphml)");
+        if (ruta.isEmpty()) {
+            return;
+        }
+        const std::string rutaLocal = ruta.toLocal8Bit().toStdString();
+        FormatoImportacion formato;
+        if (!formatoPorExtension(rutaLocal, formato)) {
+            QMessageBox::warning(this, "Importar grafo", "Formato de archivo desconocido");
+            return;
+        }
+
+        borrar(); // El grafo importado reemplaza al actual y no se puede deshacer
+        detenerDistribucion();
+        ponerImportando(true);
+        cancelarImportacion = false;
+        hiloImportacion = QThread::create([this, rutaLocal, formato] {
+            std::ifstream entrada(rutaLocal, std::ios::binary | std::ios::ate);
+            const long long total = entrada ? static_cast<long long>(entrada.tellg()) : 0; // Para mostrar el avance
+            entrada.seekg(0);
+            std::string error = "no se pudo abrir el archivo";
+            const bool correcto = entrada && importarGrafo(entrada, formato, [this, total](LoteImportado &lote) {
+                // Cada lote viaja al hilo de la ventana sin copiarse
+                auto recibido = std::make_shared<LoteImportado>(std::move(lote));
+                QMetaObject::invokeMethod(this, [this, recibido, total] { recibirLote(*recibido, total); }, Qt::QueuedConnection);
+            }, error, &cancelarImportacion);
+            QMetaObject::invokeMethod(this, [this, correcto, error] {
+                terminarImportacion(correcto, QString::fromStdString(error));
+            }, Qt::QueuedConnection);
+        });
+        connect(hiloImportacion, &QThread::finished, hiloImportacion, &QObject::deleteLater);
+        hiloImportacion->start();
+    }
+
+    // Método para escribir la matriz de distancias entre todos los pares sin
+    // bloquear la ventana; el hilo trabaja sobre una copia de la adyacencia,
+    // así el grafo se puede seguir editando mientras tanto
+    void exportarDistancias() {
+        if (hiloMatriz) {
+            return; // Ya hay una exportación en curso
+        }
+        const QString ruta = QFileDialog::getSaveFileName(this, "Exportar distancias", QString(), "Matrices de distancias (*.dist)");
+        if (ruta.isEmpty()) {
+            return;
+        }
+        const std::string rutaLocal = ruta.toLocal8Bit().toStdString();
+        auto csr = std::make_shared<Grafo::CSR>(grafo.csr());
+        cancelarMatriz = false;
+        botonDistancias->setEnabled(false);
+        hiloMatriz = QThread::create([this, csr, rutaLocal] {
+            PoolHilos hilosMatriz; // Propios: los de la ventana los usa la distribución
+            std::string error;
+            const bool correcto = exportarMatrizDistancias(csr->vista(), hilosMatriz, rutaLocal, error,
+                                                           MetodoMatriz::Automatico, &cancelarMatriz);
+            QMetaObject::invokeMethod(this, [this, correcto, error] {
+                terminarExportacion(correcto, QString::fromStdString(error));
+            }, Qt::QueuedConnection);
+        });
+        connect(hiloMatriz, &QThread::finished, hiloMatriz, &QObject::deleteLater);
+        hiloMatriz->start();
+    }
+
+    // Método para iniciar o detener la distribución automática de los puntos
+    void distribuir() {
+        if (temporizadorDistribucion.isActive()) {
+            detenerDistribucion();
+            return;
+        }
+        disposicion.iniciar(grafo);
+        botonDistribuir->setText("Detener");
+        temporizadorDistribucion.start();
+    }
+
+    // Avanza la distribución un paso; cada paso se dibuja, así se ve cómo se asienta
+    void pasoDistribucion() {
+        if (disposicion.cantidadVertices() != grafo.cantidadVertices()) {
+            disposicion.iniciar(grafo); // Se agregaron o quitaron puntos mientras se distribuía
+        }
+        disposicion.paso(grafo.csr().vista());
+
+        // Las posiciones cambian todas a la vez, así que el índice se rehace completo
+        indice.limpiar();
+        for (int v = 0; v < grafo.cantidadVertices(); ++v) {
+            grafo.moverVertice(v, disposicion.posicionesX()[v], disposicion.posicionesY()[v]);
+            indice.insertar(v, grafo.x(v), grafo.y(v));
+        }
+        capaValida = false; // La capa se vuelve a dibujar con las posiciones nuevas
+        caminoVigente = false; // Con otras posiciones cambian los largos de las aristas
+        arbolVigente = false;
+        update();
+        if (disposicion.asentada()) {
+            detenerDistribucion();
+        }
+    }
+
+    void detenerDistribucion() {
+        temporizadorDistribucion.stop();
+        botonDistribuir->setText("Distribuir");
+    }
+
+    // Método para elegir qué recorrido se muestra con colores
+    void cambiarRecorrido(int opcion) {
+        recorrido = static_cast<Recorrido>(opcion);
+        recorridoVigente = false;
+        capaValida = false;
+        textoColoreo.clear();
+        mostrarConectividad();
+        update();
+    }
+
+    // Método para mostrar u ocultar el camino más corto entre los puntos seleccionados
+    void mostrarCaminos(bool activo) {
+        caminoActivo = activo;
+        caminoVigente = false;
+        verticesCamino.clear();
+        if (!activo) {
+            setWindowTitle(tituloVentana);
+        }
+        update();
+    }
+
+    // Método para resaltar u ocultar el árbol de expansión mínima
+    void mostrarArbol(bool activo) {
+        arbolActivo = activo;
+        arbolVigente = false;
+        arbol = ArbolMinimo();
+        capaArbol = QPixmap(); // Sin el árbol no hace falta guardar su capa
+        capaArbolValida = false;
+        mostrarConectividad();
+        update();
+    }
+
     // Método para seleccionar un punto basado en la posición del clic
     void seleccionarPunto(const QPoint &punto) {
         const int radioSeleccion = 14; // Radio de selección para detectar clics en puntos
 
-        // Verifica si el clic está dentro del radio de algún punto
-        for (Punto* p : puntos) {
-            if (QLineF(p->posicion, punto).length() <= radioSeleccion) {
-                // Agrega o quita un punto de la lista de puntos seleccionados
-                if (puntosSeleccionados.contains(p)) {
-                    puntosSeleccionados.removeAll(p); // Quitar si ya está seleccionado
-                } else {
-                    puntosSeleccionados.append(p); // Agregar si no está seleccionado
-                }
-                break; // Salir del bucle después de encontrar un punto
+        // Consulta solo las celdas del índice cercanas al clic
+        int p = indice.buscar(punto.x(), punto.y(), radioSeleccion);
+        if (p >= 0) {
+            // Agrega o quita un punto de la lista de puntos seleccionados
+            if (puntosSeleccionados.contains(p)) {
+                puntosSeleccionados.removeAll(p); // Quitar si ya está seleccionado
+            } else {
+                puntosSeleccionados.append(p); // Agregar si no está seleccionado
             }
+            update(rectPunto(p)); // Solo cambia el color de este círculo
+            mostrarConectividad();
         }
-        update(); // Solicita una actualización de la ventana para redibujar
     }
 
 protected:
     // Método que se llama cuando se hace doble clic en el widget
     void mouseDoubleClickEvent(QMouseEvent *evento) override {
+        if (importando) {
+            return;
+        }
         // Permitir seleccionar puntos al hacer doble clic
         seleccionarPunto(evento->pos()); // Seleccionar el punto en la posición del doble clic
     }
 
 private:
-    // Enumeración para definir los tipos de acciones
-    enum class TipoAccion {
-        Agregar, // Acción de agregar un punto
-        Conectar // Acción de conectar dos puntos
-    };
-
-    // Estructura para almacenar información sobre una acción
-    struct Accion {
-        TipoAccion tipo; // Tipo de acción (Agregar o Conectar)
-        Punto* punto; // Puntero al punto involucrado en la acción
-        Punto* puntoConectado = nullptr; // Puntero al punto conectado (solo se usa para conexiones)
-    };
-
-    QList<Punto*> puntos; // Almacena los puntos donde se hace clic
-    QList<Punto*> puntosSeleccionados; // Almacena los puntos seleccionados
-    QStack<Accion> acciones; // Pila para deshacer acciones
+    // Posición de un punto del grafo como QPointF para dibujarlo
+    QPointF posicion(int punto) const {
+        return QPointF(grafo.x(punto), grafo.y(punto));
+    }
+
+    // Indica si el rectángulo envolvente del segmento a-b toca el área
+    static bool intersectaCaja(const QRectF &area, const QPointF &a, const QPointF &b) {
+        return std::max(a.x(), b.x()) >= area.left() && std::min(a.x(), b.x()) <= area.right()
+               && std::max(a.y(), b.y()) >= area.top() && std::min(a.y(), b.y()) <= area.bottom();
+    }
+
+    // Rectángulo que cubre el círculo de un punto, incluido el borde
+    QRect rectPunto(int punto) const {
+        const double margen = radioPunto + 2;
+        return QRectF(grafo.x(punto) - margen, grafo.y(punto) - margen, 2 * margen, 2 * margen).toAlignedRect();
+    }
+
+    // Segmentos de las aristas de un lote, tomados del final de cada lista
+    // Todo lote nuevo pasa por aquí, así que también se lleva la arista más larga
+    void lineasDeLote(const Grafo::LoteAristas &lote, QVector<QLineF> &salida) {
+        salida.clear();
+        for (size_t i = 0; i < lote.vertices.size(); ++i) {
+            const PoolAdyacencia::Lista lista = grafo.aristasDe(lote.vertices[i]);
+            for (size_t k = lista.size() - lote.agregadas[i]; k < lista.size(); ++k) {
+                salida.append(QLineF(posicion(lote.vertices[i]), posicion(lista[k])));
+                largoMaximo = std::max(largoMaximo, salida.back().length());
+            }
+        }
+    }
+
+    // Rectángulo que cubre todas las aristas de un lote
+    QRect rectLote(const Grafo::LoteAristas &lote) {
+        QRect rect;
+        lineasDeLote(lote, lineas);
+        for (const QLineF &linea : lineas) {
+            rect |= QRectF(linea.p1(), linea.p2()).normalized().adjusted(-2, -2, 2, 2).toAlignedRect();
+        }
+        return rect;
+    }
+
+    // Dibuja el grafo sin selección (puntos negros y luego líneas), solo lo que toca el área
+    void dibujarGrafo(QPainter &pintor, const QRect &area) {
+        const double margen = radioPunto + 1; // Cubre el radio y el lápiz
+        const QRectF areaPuntos = QRectF(area).adjusted(-margen, -margen, margen, margen);
+
+        // Dibuja los puntos visibles con un solo pincel, o con el color de su resultado si hay un recorrido
+        pintor.setPen(Qt::black);
+        pintor.setBrush(Qt::black);
+        const bool colores = recorrido != Recorrido::Ninguno;
+        visibles.clear();
+        indice.consultar(areaPuntos.left(), areaPuntos.top(), areaPuntos.right(), areaPuntos.bottom(), visibles);
+        for (int punto : visibles) {
+            if (colores) {
+                pintor.setBrush(colorRecorrido(punto));
+            }
+            pintor.drawEllipse(posicion(punto), radioPunto, radioPunto); // Dibuja un círculo de radio 7
+        }
+
+        // Dibuja líneas entre los puntos conectados; todas las aristas visibles van en una sola llamada a drawLines
+        const QRectF areaLineas = QRectF(area).adjusted(-1, -1, 1, 1);
+        lineas.clear(); // Conserva la capacidad del cuadro anterior
+        auto agregarAristas = [&](int punto) {
+            for (int puntoConectado : grafo.aristasDe(punto)) {
+                // Se descarta la arista si su rectángulo envolvente no toca el área
+                if (intersectaCaja(areaLineas, posicion(punto), posicion(puntoConectado))) {
+                    lineas.append(QLineF(posicion(punto), posicion(puntoConectado))); // Cada arista se guarda una sola vez
+                }
+            }
+        };
+        if (area.contains(rect())) {
+            // Dibujo completo: se recorren todas las aristas y de paso se mide la más larga
+            largoMaximo = 0;
+            for (int punto = 0; punto < grafo.cantidadVertices(); ++punto) {
+                for (int puntoConectado : grafo.aristasDe(punto)) {
+                    largoMaximo = std::max(largoMaximo, QLineF(posicion(punto), posicion(puntoConectado)).length());
+                }
+                agregarAristas(punto);
+            }
+        } else {
+            // Una arista que toca el área tiene sus dos extremos a menos de largoMaximo de ella,
+            // así que basta con las listas de los puntos del área ampliada (cada arista está en una sola)
+            const QRectF areaExtremos = areaLineas.adjusted(-largoMaximo, -largoMaximo, largoMaximo, largoMaximo);
+            visibles.clear(); // Los puntos ya se dibujaron, se reutiliza el vector
+            indice.consultar(areaExtremos.left(), areaExtremos.top(), areaExtremos.right(), areaExtremos.bottom(), visibles);
+            for (int punto : visibles) {
+                agregarAristas(punto);
+            }
+        }
+        pintor.drawLines(lineas);
+    }
+
+    // Crea la capa estática del tamaño del widget y dibuja en ella todo el grafo
+    void reconstruirCapa() {
+        const qreal escala = devicePixelRatioF();
+        capa = QPixmap(size() * escala);
+        capa.setDevicePixelRatio(escala);
+        capa.fill(Qt::transparent); // El fondo lo pone el widget
+        QPainter pintorCapa(&capa);
+        dibujarGrafo(pintorCapa, rect());
+        capaValida = true;
+    }
+
+    // Crea la capa del árbol de expansión mínima, del mismo tamaño que la del grafo
+    void reconstruirCapaArbol() {
+        const qreal escala = devicePixelRatioF();
+        capaArbol = QPixmap(size() * escala);
+        capaArbol.setDevicePixelRatio(escala);
+        capaArbol.fill(Qt::transparent);
+        lineas.clear();
+        for (size_t i = 0; i + 1 < arbol.aristas.size(); i += 2) {
+            lineas.append(QLineF(posicion(arbol.aristas[i]), posicion(arbol.aristas[i + 1])));
+        }
+        QPainter pintorCapa(&capaArbol);
+        pintorCapa.setPen(QPen(QColor(20, 160, 60), 3));
+        pintorCapa.drawLines(lineas);
+        capaArbolValida = true;
+    }
+
+    // Vuelve a dibujar solo un área de la capa estática tras un cambio en el grafo
+    void actualizarCapa(const QRect &area) {
+        if (!capaValida) {
+            return; // Se reconstruirá completa en el próximo dibujo
+        }
+        if (recorridoDesactualizado()) {
+            capaValida = false; // El cambio altera los colores de otros puntos: se redibuja todo
+            return;
+        }
+        QPainter pintorCapa(&capa);
+        pintorCapa.setClipRect(area);
+        pintorCapa.setCompositionMode(QPainter::CompositionMode_Source);
+        pintorCapa.fillRect(area, Qt::transparent); // Borra lo que había en el área
+        pintorCapa.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        dibujarGrafo(pintorCapa, area);
+    }
+
+    // Punto de partida de BFS y DFS: el primero seleccionado, o el 0 si no hay selección
+    int origenRecorrido() const {
+        return puntosSeleccionados.isEmpty() ? 0 : puntosSeleccionados.first();
+    }
+
+    // Indica si el resultado mostrado ya no corresponde al grafo o al origen actuales
+    bool recorridoDesactualizado() const {
+        return recorrido != Recorrido::Ninguno
+               && (!recorridoVigente || versionRecorrido != grafo.version()
+                   || (usaOrigen() && origenCalculado != origenRecorrido()));
+    }
+
+    // Solo los recorridos parten del punto seleccionado; las componentes y los coloreos no
+    bool usaOrigen() const {
+        return recorrido == Recorrido::Anchura || recorrido == Recorrido::Profundidad;
+    }
+
+    // Ejecuta el recorrido elegido sobre la CSR del grafo
+    void calcularRecorrido() {
+        const VistaCSR csr = grafo.csr().vista();
+        origenCalculado = origenRecorrido();
+        const auto inicio = std::chrono::steady_clock::now(); // Sin contar la construcción de la CSR
+        int colores = 0;
+        if (recorrido == Recorrido::Anchura) {
+            resultadoRecorrido = recorridoAnchura(csr, origenCalculado);
+        } else if (recorrido == Recorrido::Profundidad) {
+            resultadoRecorrido = recorridoProfundidad(csr, origenCalculado);
+        } else if (recorrido == Recorrido::Componentes) {
+            componentesConexas(csr, resultadoRecorrido);
+        } else if (recorrido == Recorrido::ColoreoVoraz) {
+            colores = coloreoVoraz(csr, resultadoRecorrido);
+        } else if (recorrido == Recorrido::ColoreoDSatur) {
+            colores = coloreoDSatur(csr, resultadoRecorrido);
+        } else {
+            colores = coloreoParalelo(csr, hilos, resultadoRecorrido);
+        }
+        const double milisegundos = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+        maximoRecorrido = resultadoRecorrido.empty() ? 0 : *std::max_element(resultadoRecorrido.begin(), resultadoRecorrido.end());
+        versionRecorrido = grafo.version();
+        recorridoVigente = true;
+
+        // Los coloreos informan cuántos colores usaron y cuánto tardaron, para compararlos
+        textoColoreo.clear();
+        if (recorrido >= Recorrido::ColoreoVoraz) {
+            textoColoreo = QString(" - %1 colores en %2 ms").arg(colores).arg(milisegundos, 0, 'f', 1);
+        }
+        mostrarConectividad();
+    }
+
+    // Color de un punto según el resultado del recorrido
+    QColor colorRecorrido(int punto) const {
+        if (punto >= static_cast<int>(resultadoRecorrido.size())) {
+            return Qt::black;
+        }
+        const int valor = resultadoRecorrido[punto];
+        if (valor < 0) {
+            return Qt::lightGray; // No se alcanza desde el origen
+        }
+        if (recorrido == Recorrido::Anchura) {
+            return QColor::fromHsv((valor * 40) % 360, 200, 230); // Un tono por nivel
+        }
+        if (recorrido == Recorrido::Profundidad) {
+            // De rojo a violeta según el orden en que se descubrió
+            return QColor::fromHsv(static_cast<int>(270LL * valor / std::max(1, maximoRecorrido)), 200, 230);
+        }
+        return QColor::fromHsv(static_cast<int>(valor * 137.508) % 360, 200, 230); // Tonos bien separados por componente o color
+    }
+
+    // Muestra la cantidad de componentes y si los dos puntos seleccionados están conectados
+    void mostrarConectividad() {
+        QString texto = QString("Componentes: %1").arg(conectividad.cantidadComponentes());
+        if (puntosSeleccionados.size() == 2) {
+            texto += conectividad.conectados(puntosSeleccionados[0], puntosSeleccionados[1]) ? " (conectados)" : " (no conectados)";
+        }
+        if (arbolActivo && arbolVigente) {
+            texto += QString(" - árbol de %1 px").arg(arbol.largo, 0, 'f', 1);
+        }
+        texto += textoColoreo; // Vacío si no se muestra un coloreo
+        if (!seleccionBusqueda.isEmpty() && seleccionBusqueda == puntosSeleccionados) {
+            texto += textoBusqueda; // Solo mientras se ve el resultado tal como quedó
+        }
+        etiquetaConectividad->setText(texto);
+    }
+
+    // Calcula el árbol (o bosque) de expansión mínima con el largo de cada arista como peso
+    void calcularArbol() {
+        arbol = arbolMinimo(grafo.csr().vista(), grafo.posicionesX().data(), grafo.posicionesY().data(), hilos);
+        versionArbol = grafo.version();
+        arbolVigente = true;
+        capaArbolValida = false;
+        mostrarConectividad();
+    }
+
+    // Indica si hay que volver a buscar el camino porque cambió el grafo o la selección
+    bool caminoDesactualizado() const {
+        return caminoActivo
+               && (!caminoVigente || versionCamino != grafo.version() || seleccionCamino != puntosSeleccionados);
+    }
+
+    // Busca con A* el camino más corto que pasa por los puntos seleccionados, en
+    // el orden en que se seleccionaron. El buscador conserva sus arreglos entre
+    // consultas, así que seleccionar puntos uno tras otro no reserva memoria
+    void calcularCamino() {
+        const VistaCSR csr = grafo.csr().vista();
+        const double *xs = grafo.posicionesX().data();
+        const double *ys = grafo.posicionesY().data();
+        verticesCamino.clear();
+        double largo = 0;
+        for (int i = 1; i < puntosSeleccionados.size(); ++i) {
+            largo += buscador.caminoMasCorto(csr, xs, ys, puntosSeleccionados[i - 1], puntosSeleccionados[i]);
+            if (std::isinf(largo)) {
+                verticesCamino.clear(); // Algún par no está conectado
+                break;
+            }
+            buscador.camino(puntosSeleccionados[i], tramo);
+            // Cada tramo empieza donde terminó el anterior
+            verticesCamino.insert(verticesCamino.end(), tramo.begin() + (verticesCamino.empty() ? 0 : 1), tramo.end());
+        }
+
+        if (!importando) {
+            if (puntosSeleccionados.size() < 2) {
+                setWindowTitle(tituloVentana);
+            } else if (std::isinf(largo)) {
+                setWindowTitle(QString("%1 - sin camino").arg(tituloVentana));
+            } else {
+                setWindowTitle(QString("%1 - camino de %2 px").arg(tituloVentana).arg(largo, 0, 'f', 1));
+            }
+        }
+        seleccionCamino = puntosSeleccionados;
+        versionCamino = grafo.version();
+        caminoVigente = true;
+    }
+
+    // Agrega al grafo un lote recibido del hilo de importación y lo muestra
+    void recibirLote(const LoteImportado &lote, long long total) {
+        const int primero = grafo.cantidadVertices();
+        for (int v : lote.reubicados) {
+            indice.eliminar(v, grafo.x(v), grafo.y(v)); // Se vuelven a registrar en su posición nueva
+        }
+        agregarLoteImportado(grafo, lote);
+        for (int v : lote.reubicados) {
+            indice.insertar(v, grafo.x(v), grafo.y(v));
+        }
+        for (int v = primero; v < grafo.cantidadVertices(); ++v) {
+            indice.insertar(v, grafo.x(v), grafo.y(v)); // Registrar cada punto en el índice espacial
+            conectividad.agregarVertice();
+        }
+        for (size_t i = 0; i + 1 < lote.aristas.size(); i += 2) {
+            conectividad.unir(lote.aristas[i], lote.aristas[i + 1]); // Nada de la importación se puede deshacer
+        }
+        mostrarConectividad();
+        if (total > 0) {
+            setWindowTitle(QString("%1 - importando %2%").arg(tituloVentana).arg(static_cast<int>(100 * lote.bytesLeidos / total)));
+        }
+        capaValida = false; // Varios lotes seguidos se juntan en un solo dibujo
+        update();
+    }
+
+    // Se llama en el hilo de la ventana cuando el hilo de importación termina
+    void terminarImportacion(bool correcto, const QString &error) {
+        hiloImportacion = nullptr;
+        ponerImportando(false);
+        setWindowTitle(tituloVentana);
+        if (!correcto) {
+            borrar(); // No se deja un grafo importado a medias
+            QMessageBox::warning(this, "Importar grafo", error);
+        }
+    }
+
+    // Se llama en el hilo de la ventana cuando termina la exportación de distancias
+    void terminarExportacion(bool correcto, const QString &error) {
+        hiloMatriz = nullptr;
+        botonDistancias->setEnabled(!importando);
+        if (!correcto) {
+            QMessageBox::warning(this, "Exportar distancias", error);
+        }
+    }
+
+    // Habilita o deshabilita la edición mientras dura una importación
+    void ponerImportando(bool valor) {
+        importando = valor;
+        for (QPushButton *boton : botones) {
+            boton->setEnabled(!valor);
+        }
+        botonDistancias->setEnabled(!valor && !hiloMatriz); // Sigue deshabilitado si hay una exportación en curso
+        botonConjuntos->setEnabled(!valor && !hiloBusqueda); // Y este si hay una búsqueda en curso
+        actualizarBotonesHistorial(); // Y estos si no hay nada que deshacer o rehacer
+    }
+
+    // Guarda una acción ya aplicada y abre su paso en la conectividad; si el
+    // historial descartó acciones viejas por el límite, sus pasos también se descartan
+    void registrarAccion(Historial::Comando comando) {
+        historial.registrar(std::move(comando));
+        conectividad.abrirPaso(); // Un paso por acción del historial
+        conectividad.descartarPasos(historial.tomarDescartados());
+        actualizarBotonesHistorial();
+    }
+
+    // Deshacer y Rehacer se habilitan solo si hay algo que deshacer o rehacer;
+    // la memoria que ocupa el historial se muestra al pasar el mouse por Deshacer
+    void actualizarBotonesHistorial() {
+        botonDeshacer->setEnabled(!importando && historial.puedeDeshacer());
+        botonRehacer->setEnabled(!importando && historial.puedeRehacer());
+        botonDeshacer->setToolTip(QString("Historial: %1 KiB").arg(static_cast<qulonglong>(historial.bytesUsados() / 1024)));
+    }
+
+    // Recorridos que se pueden mostrar, en el orden del selector
+    enum class Recorrido { Ninguno, Anchura, Profundidad, Componentes, ColoreoVoraz, ColoreoDSatur, ColoreoParalelo };
+
+    // Formas de conectar los puntos del menú "Autoconectar"
+    enum class Autoconexion { Delaunay, ArbolEuclidiano, Vecinos };
+
+    static constexpr int vecinosAutoconexion = 6; // Vecinos por punto en la opción de vecinos más cercanos
+
+    // Conecta la selección (o todos los puntos si hay menos de dos
+    // seleccionados) sin formar la clique completa; se deshace de una sola vez
+    void autoconectar(Autoconexion forma) {
+        std::vector<int> ids;
+        if (puntosSeleccionados.size() >= 2) {
+            ids.assign(puntosSeleccionados.begin(), puntosSeleccionados.end());
+        } else {
+            ids.resize(grafo.cantidadVertices());
+            std::iota(ids.begin(), ids.end(), 0);
+        }
+        std::vector<double> xs(ids.size()), ys(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            xs[i] = grafo.x(ids[i]);
+            ys[i] = grafo.y(ids[i]);
+        }
+        const int n = static_cast<int>(ids.size());
+        std::vector<int> pares;
+        if (forma == Autoconexion::Delaunay) {
+            pares = triangulacionDelaunay(xs.data(), ys.data(), n);
+        } else if (forma == Autoconexion::ArbolEuclidiano) {
+            pares = arbolEuclidiano(xs.data(), ys.data(), n);
+        } else {
+            pares = vecinosMasCercanos(xs.data(), ys.data(), n, vecinosAutoconexion);
+        }
+        for (int &v : pares) {
+            v = ids[v]; // De índice en la selección a id del grafo
+        }
+
+        // Quedan solo las aristas que no existían, y esas se guardan para deshacer
+        const Grafo::LoteAristas lote = grafo.conectarAristas(pares);
+        puntosSeleccionados.clear();
+        if (!lote.vertices.empty()) {
+            if (capaValida) {
+                lineasDeLote(lote, lineas);
+                QPainter pintorCapa(&capa);
+                pintorCapa.setPen(Qt::black);
+                pintorCapa.drawLines(lineas);
+            }
+            registrarAccion(Historial::conectarAristas(pares));
+            conectividad.unirLote(grafo, lote);
+        }
+        mostrarConectividad();
+        update(); // Las aristas nuevas pueden estar en cualquier parte
+    }
+
+    static constexpr long long limiteNodosBusqueda = 2000000; // Unos segundos como máximo; después se corta
+
+    // Busca una clique máxima o un conjunto independiente máximo en un hilo
+    // aparte, sobre una copia de la adyacencia, y lo deja seleccionado al terminar
+    void seleccionarConjunto(bool clique) {
+        if (hiloBusqueda) {
+            return; // Ya hay una búsqueda en curso
+        }
+        auto csr = std::make_shared<Grafo::CSR>(grafo.csr());
+        const std::uint64_t version = grafo.version();
+        botonConjuntos->setEnabled(false);
+        hiloBusqueda = QThread::create([this, csr, clique, version] {
+            auto conjunto = std::make_shared<ConjuntoMaximo>(clique ? cliqueMaxima(csr->vista(), limiteNodosBusqueda)
+                                                                    : conjuntoIndependienteMaximo(csr->vista(), limiteNodosBusqueda));
+            QMetaObject::invokeMethod(this, [this, conjunto, clique, version] {
+                terminarBusqueda(*conjunto, clique, version);
+            }, Qt::QueuedConnection);
+        });
+        connect(hiloBusqueda, &QThread::finished, hiloBusqueda, &QObject::deleteLater);
+        hiloBusqueda->start();
+    }
+
+    // Se llama en el hilo de la ventana cuando termina la búsqueda; si el grafo
+    // cambió mientras tanto el resultado ya no vale y se descarta
+    void terminarBusqueda(const ConjuntoMaximo &conjunto, bool clique, std::uint64_t version) {
+        hiloBusqueda = nullptr;
+        botonConjuntos->setEnabled(!importando);
+        if (version != grafo.version()) {
+            return;
+        }
+        puntosSeleccionados.clear();
+        for (int punto : conjunto.vertices) {
+            puntosSeleccionados.append(punto);
+        }
+        seleccionBusqueda = puntosSeleccionados;
+        textoBusqueda = QString(" - %1 de %2 puntos").arg(clique ? "clique" : "conjunto independiente").arg(static_cast<int>(conjunto.vertices.size()));
+        if (!conjunto.exacto) {
+            textoBusqueda += " (puede haber uno mayor)"; // Se agotó el límite de la búsqueda
+        }
+        mostrarConectividad();
+        update(); // La selección anterior y la nueva pueden estar en cualquier parte
+    }
+
+    static constexpr double radioPunto = 7; // Radio con el que se dibuja cada punto
+    static constexpr const char *tituloVentana = "Programa Representación de Grafos";
+
+    Grafo grafo; // Almacena los puntos donde se hace clic y sus conexiones
+    QList<int> puntosSeleccionados; // Almacena los ids de los puntos seleccionados
+    Historial historial; // Historial de deshacer y rehacer, con memoria acotada
+    IndiceEspacial indice; // Rejilla para encontrar puntos por posición
+    QVector<QLineF> lineas; // Segmentos de las aristas, reutilizado entre cuadros
+    std::vector<int> visibles; // Puntos dentro de la región expuesta, reutilizado entre cuadros
+    double largoMaximo = 0; // Cota de la arista más larga; se recalcula con cada dibujo completo de la capa
+    QPixmap capa; // Grafo sin selección ya dibujado; la selección se pinta encima
+    bool capaValida = false; // Falso cuando hay que volver a dibujar la capa completa
+    QList<QPushButton *> botones; // Se deshabilitan durante una importación
+    PoolHilos hilos; // Hilos para los cálculos en paralelo, creados una sola vez
+    DisposicionFuerzas disposicion; // Distribución automática de los puntos
+    QTimer temporizadorDistribucion; // Marca el ritmo de la animación de la distribución
+    QPushButton *botonDistribuir; // Cambia entre "Distribuir" y "Detener"
+    QLabel *etiquetaConectividad; // Muestra la cantidad de componentes
+    QPushButton *botonDistancias; // Se deshabilita mientras se exporta la matriz
+    QPointer<QThread> hiloMatriz; // Hilo de la exportación de distancias en curso, si hay una
+    QPushButton *botonConjuntos; // Se deshabilita mientras se busca
+    QPushButton *botonDeshacer; // Habilitados solo si hay algo que deshacer o rehacer
+    QPushButton *botonRehacer;
+    QPointer<QThread> hiloBusqueda; // Hilo de la búsqueda de clique o conjunto en curso, si hay una
+    std::atomic<bool> cancelarMatriz{false}; // Pide al hilo de la exportación que se detenga
+    Conectividad conectividad; // Componentes conexas, actualizadas con cada edición y cada deshacer
+    QPointer<QThread> hiloImportacion; // Hilo de la importación en curso, si hay una
+    std::atomic<bool> cancelarImportacion{false}; // Pide al hilo que se detenga
+    bool importando = false; // Verdadero mientras llegan lotes de una importación
+    Recorrido recorrido = Recorrido::Ninguno; // Recorrido que se muestra con colores
+    QString textoColoreo; // Colores y tiempo del último coloreo, para la etiqueta
+    QList<int> seleccionBusqueda; // Última clique o conjunto independiente seleccionado
+    QString textoBusqueda; // Su tamaño, que se muestra mientras siga seleccionado
+    std::vector<int> resultadoRecorrido; // Distancia, orden de descubrimiento o componente de cada punto
+    int maximoRecorrido = 0; // Mayor valor del resultado, para repartir los colores
+    int origenCalculado = -1; // Origen con que se calculó el resultado
+    std::uint64_t versionRecorrido = 0; // Versión del grafo con que se calculó el resultado
+    bool recorridoVigente = false; // Falso si todavía no se calculó el recorrido elegido
+    BuscadorCaminos buscador; // Caminos más cortos, con arreglos reutilizados entre consultas
+    bool caminoActivo = false; // Verdadero mientras está pulsado el botón Camino
+    bool caminoVigente = false; // Falso si el camino mostrado hay que volver a buscarlo
+    std::vector<int> verticesCamino; // Camino que pasa por todos los seleccionados, en orden
+    std::vector<int> tramo; // Camino entre dos seleccionados seguidos, reutilizado
+    QList<int> seleccionCamino; // Selección con que se buscó el camino
+    std::uint64_t versionCamino = 0; // Versión del grafo con que se buscó el camino
+    ArbolMinimo arbol; // Árbol de expansión mínima que se resalta
+    bool arbolActivo = false; // Verdadero mientras está pulsado el botón Árbol
+    bool arbolVigente = false; // Falso si hay que volver a calcular el árbol
+    QPixmap capaArbol; // Árbol ya dibujado, que se pinta sobre la capa del grafo
+    bool capaArbolValida = false; // Falso cuando el árbol cambió y hay que volver a dibujarlo
+    std::uint64_t versionArbol = 0; // Versión del grafo con que se calculó el árbol
 
 };
 
 // Función principal de la aplicación
 int main(int argc, char *argv[]) {
+    // En modo por lotes no se crea QApplication ni ventana: arranca en milisegundos y sin pantalla
+    if (esModoLote(argc, argv)) {
+        return ejecutarLote(argc, argv);
+    }
+
     QApplication app(argc, argv); // Inicializa la aplicación Qt
 
     MiWidget ventana; // Crea una instancia del widget principal
+    // QApplication ya quitó sus propias opciones de argv
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--historial-mb") == 0) {
+            ventana.setLimiteHistorial(static_cast<size_t>(std::strtoull(argv[i + 1], nullptr, 10)) * 1024 * 1024);
+        }
+    }
     ventana.show(); // Muestra la ventana
 
     return app.exec(); // Ejecuta el bucle de eventos de la aplicación
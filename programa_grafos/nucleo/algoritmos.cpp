@@ -0,0 +1,85 @@
+#include "algoritmos.h"
+
+std::vector<int> recorridoAnchura(const VistaCSR &grafo, int origen)
+{
+    std::vector<int> distancia(grafo.n, -1);
+    if (origen < 0 || origen >= grafo.n) {
+        return distancia;
+    }
+
+    // La cola es un arreglo de n casillas: cada vértice entra una sola vez
+    std::vector<int> cola(grafo.n);
+    int frente = 0, fin = 0;
+    cola[fin++] = origen;
+    distancia[origen] = 0;
+    while (frente < fin) {
+        const int v = cola[frente++];
+        for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+            const int w = grafo.vecinos[k];
+            if (distancia[w] < 0) {
+                distancia[w] = distancia[v] + 1;
+                cola[fin++] = w;
+            }
+        }
+    }
+    return distancia;
+}
+
+std::vector<int> recorridoProfundidad(const VistaCSR &grafo, int origen)
+{
+    std::vector<int> orden(grafo.n, -1);
+    if (origen < 0 || origen >= grafo.n) {
+        return orden;
+    }
+
+    // La pila guarda cada vértice abierto junto con el próximo vecino por revisar,
+    // así se visitan los vecinos en el mismo orden que la versión recursiva
+    std::vector<int> pila(grafo.n), siguiente(grafo.n);
+    int alto = 0, descubiertos = 0;
+    pila[alto] = origen;
+    siguiente[alto++] = grafo.inicio[origen];
+    orden[origen] = descubiertos++;
+    while (alto > 0) {
+        const int v = pila[alto - 1];
+        int &k = siguiente[alto - 1];
+        while (k < grafo.inicio[v + 1] && orden[grafo.vecinos[k]] >= 0) {
+            ++k;
+        }
+        if (k == grafo.inicio[v + 1]) {
+            --alto; // Se terminaron los vecinos de v
+            continue;
+        }
+        const int w = grafo.vecinos[k++];
+        orden[w] = descubiertos++;
+        pila[alto] = w;
+        siguiente[alto++] = grafo.inicio[w];
+    }
+    return orden;
+}
+
+int componentesConexas(const VistaCSR &grafo, std::vector<int> &etiqueta)
+{
+    etiqueta.assign(grafo.n, -1);
+    std::vector<int> cola(grafo.n); // Se reutiliza para todas las componentes
+    int componentes = 0;
+    for (int inicio = 0; inicio < grafo.n; ++inicio) {
+        if (etiqueta[inicio] >= 0) {
+            continue;
+        }
+        int frente = 0, fin = 0;
+        cola[fin++] = inicio;
+        etiqueta[inicio] = componentes;
+        while (frente < fin) {
+            const int v = cola[frente++];
+            for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+                const int w = grafo.vecinos[k];
+                if (etiqueta[w] < 0) {
+                    etiqueta[w] = componentes;
+                    cola[fin++] = w;
+                }
+            }
+        }
+        ++componentes;
+    }
+    return componentes;
+}
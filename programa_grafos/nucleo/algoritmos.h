@@ -0,0 +1,21 @@
+#ifndef ALGORITMOS_H
+#define ALGORITMOS_H
+
+#include <vector>
+
+#include "grafo.h"
+
+// Recorrido en anchura desde origen; devuelve la distancia en aristas a cada
+// vértice (-1 si no es alcanzable). Iterativo, con una cola en un arreglo
+std::vector<int> recorridoAnchura(const VistaCSR &grafo, int origen);
+
+// Recorrido en profundidad desde origen; devuelve en qué posición se
+// descubrió cada vértice (0 para origen, -1 si no es alcanzable). Iterativo,
+// con una pila explícita, así que no depende de la profundidad del grafo
+std::vector<int> recorridoProfundidad(const VistaCSR &grafo, int origen);
+
+// Etiqueta cada vértice con el número de su componente conexa (0, 1, ...) y
+// devuelve la cantidad de componentes
+int componentesConexas(const VistaCSR &grafo, std::vector<int> &etiqueta);
+
+#endif // ALGORITMOS_H
@@ -0,0 +1,215 @@
+#include "arbolminimo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+
+namespace {
+
+const int limiteKruskal = 200000; // Con más aristas, ordenarlas cuesta más que las rondas de Borůvka
+
+// Arista con su largo; a < b. El orden es estricto: largo, luego a, luego b
+struct AristaPesada {
+    double largo;
+    int a, b;
+
+    bool operator<(const AristaPesada &otra) const
+    {
+        if (largo != otra.largo) {
+            return largo < otra.largo;
+        }
+        return a != otra.a ? a < otra.a : b < otra.b;
+    }
+    bool operator>(const AristaPesada &otra) const { return otra < *this; }
+};
+
+AristaPesada pesar(const double *xs, const double *ys, int v, int w)
+{
+    const int a = std::min(v, w), b = std::max(v, w);
+    const double dx = xs[a] - xs[b], dy = ys[a] - ys[b];
+    return {std::sqrt(dx * dx + dy * dy), a, b};
+}
+
+// Union-find con compresión de caminos; aquí nunca hace falta revertir una unión
+class Conjuntos {
+public:
+    explicit Conjuntos(int n) : padres(n) { std::iota(padres.begin(), padres.end(), 0); }
+
+    int raiz(int v)
+    {
+        while (padres[v] != v) {
+            padres[v] = padres[padres[v]]; // Cada paso acorta el camino a la mitad
+            v = padres[v];
+        }
+        return v;
+    }
+
+    bool unir(int a, int b)
+    {
+        a = raiz(a);
+        b = raiz(b);
+        if (a == b) {
+            return false;
+        }
+        padres[std::max(a, b)] = std::min(a, b);
+        return true;
+    }
+
+private:
+    std::vector<int> padres;
+};
+
+void agregar(ArbolMinimo &arbol, const AristaPesada &arista)
+{
+    arbol.aristas.push_back(arista.a);
+    arbol.aristas.push_back(arista.b);
+    arbol.largo += arista.largo;
+}
+
+} // namespace
+
+ArbolMinimo arbolKruskal(const VistaCSR &grafo, const double *xs, const double *ys)
+{
+    std::vector<AristaPesada> aristas;
+    aristas.reserve(grafo.n > 0 ? grafo.inicio[grafo.n] / 2 : 0);
+    for (int v = 0; v < grafo.n; ++v) {
+        for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+            if (grafo.vecinos[k] > v) {
+                aristas.push_back(pesar(xs, ys, v, grafo.vecinos[k])); // Cada arista una vez
+            }
+        }
+    }
+    std::sort(aristas.begin(), aristas.end());
+
+    ArbolMinimo arbol;
+    Conjuntos conjuntos(grafo.n);
+    for (const AristaPesada &arista : aristas) {
+        if (conjuntos.unir(arista.a, arista.b)) {
+            agregar(arbol, arista);
+        }
+    }
+    return arbol;
+}
+
+ArbolMinimo arbolPrim(const VistaCSR &grafo, const double *xs, const double *ys)
+{
+    ArbolMinimo arbol;
+    std::vector<char> enArbol(grafo.n, 0);
+    std::priority_queue<AristaPesada, std::vector<AristaPesada>, std::greater<AristaPesada>> candidatas;
+    auto incorporar = [&](int v) {
+        enArbol[v] = 1;
+        for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+            if (!enArbol[grafo.vecinos[k]]) {
+                candidatas.push(pesar(xs, ys, v, grafo.vecinos[k]));
+            }
+        }
+    };
+
+    // Un árbol por componente: se vuelve a empezar desde cada vértice que quedó afuera
+    for (int inicio = 0; inicio < grafo.n; ++inicio) {
+        if (enArbol[inicio]) {
+            continue;
+        }
+        incorporar(inicio);
+        while (!candidatas.empty()) {
+            const AristaPesada arista = candidatas.top();
+            candidatas.pop();
+            if (enArbol[arista.a] && enArbol[arista.b]) {
+                continue; // Quedó adentro después de agregarse
+            }
+            agregar(arbol, arista);
+            incorporar(enArbol[arista.a] ? arista.b : arista.a);
+        }
+    }
+    return arbol;
+}
+
+ArbolMinimo arbolBoruvka(const VistaCSR &grafo, const double *xs, const double *ys, PoolHilos &hilos)
+{
+    const int n = grafo.n;
+    ArbolMinimo arbol;
+    Conjuntos conjuntos(n);
+    std::vector<int> componente(n); // Raíz de la componente de cada vértice al empezar la ronda
+    std::iota(componente.begin(), componente.end(), 0);
+    std::vector<int> mejorVecino(n); // Extremo de la arista más corta que sale de cada vértice
+    std::vector<int> mejorDe(n, -1); // Vértice con la arista más corta de cada componente
+
+    // El largo de cada entrada de la CSR se calcula una sola vez, no en cada ronda
+    std::vector<double> largos(n > 0 ? grafo.inicio[n] : 0);
+    hilos.paraCada(n, [&](int inicio, int fin) {
+        for (int v = inicio; v < fin; ++v) {
+            for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+                largos[k] = pesar(xs, ys, v, grafo.vecinos[k]).largo;
+            }
+        }
+    });
+    // Menor según el orden estricto de AristaPesada, sin armar la arista
+    auto menor = [](double largoA, int a1, int a2, double largoB, int b1, int b2) {
+        return AristaPesada{largoA, std::min(a1, a2), std::max(a1, a2)}
+               < AristaPesada{largoB, std::min(b1, b2), std::max(b1, b2)};
+    };
+    std::vector<double> mejorLargo(n); // Largo de la arista de mejorVecino
+
+    for (;;) {
+        // Cada vértice busca, en paralelo, su arista más corta hacia otra componente
+        hilos.paraCada(n, [&](int inicio, int fin) {
+            for (int v = inicio; v < fin; ++v) {
+                int mejor = -1;
+                double largo = 0;
+                const int propia = componente[v];
+                for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+                    const int w = grafo.vecinos[k];
+                    if (componente[w] != propia && (mejor < 0 || menor(largos[k], v, w, largo, v, mejor))) {
+                        mejor = w;
+                        largo = largos[k];
+                    }
+                }
+                mejorVecino[v] = mejor;
+                mejorLargo[v] = largo;
+            }
+        });
+
+        // La más corta de cada componente, entre las de sus vértices
+        for (int v = 0; v < n; ++v) {
+            if (mejorVecino[v] < 0) {
+                continue;
+            }
+            int &actual = mejorDe[componente[v]];
+            if (actual < 0 || menor(mejorLargo[v], v, mejorVecino[v], mejorLargo[actual], actual, mejorVecino[actual])) {
+                actual = v;
+            }
+        }
+
+        // Con el orden estricto las aristas elegidas no forman ciclos; una misma
+        // arista puede elegirla cada uno de sus lados, y la segunda vez no une nada
+        bool unio = false;
+        for (int c = 0; c < n; ++c) {
+            const int v = mejorDe[c];
+            if (v < 0) {
+                continue;
+            }
+            mejorDe[c] = -1;
+            if (conjuntos.unir(v, mejorVecino[v])) {
+                agregar(arbol, {mejorLargo[v], std::min(v, mejorVecino[v]), std::max(v, mejorVecino[v])});
+                unio = true;
+            }
+        }
+        if (!unio) {
+            return arbol; // Ninguna componente tiene aristas hacia otra
+        }
+        for (int v = 0; v < n; ++v) {
+            componente[v] = conjuntos.raiz(v);
+        }
+    }
+}
+
+ArbolMinimo arbolMinimo(const VistaCSR &grafo, const double *xs, const double *ys, PoolHilos &hilos)
+{
+    const int aristas = grafo.n > 0 ? grafo.inicio[grafo.n] / 2 : 0;
+    // Con un solo hilo Borůvka no compensa: sus rondas recorren todas las aristas cada vez
+    if (aristas <= limiteKruskal || hilos.cantidadHilos() == 1) {
+        return arbolKruskal(grafo, xs, ys);
+    }
+    return arbolBoruvka(grafo, xs, ys, hilos);
+}
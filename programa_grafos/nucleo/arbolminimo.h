@@ -0,0 +1,31 @@
+#ifndef ARBOLMINIMO_H
+#define ARBOLMINIMO_H
+
+#include <vector>
+
+#include "grafo.h"
+#include "poolhilos.h"
+
+// Árbol (o bosque, si el grafo no es conexo) de expansión mínima, donde el
+// peso de cada arista es la distancia euclidiana entre sus extremos. Los
+// empates de largo se desempatan por los ids de los extremos, así las tres
+// versiones devuelven exactamente las mismas aristas
+struct ArbolMinimo {
+    std::vector<int> aristas; // Pares a, b consecutivos, con a < b
+    double largo = 0; // Suma de los largos de las aristas
+};
+
+// Ordena todas las aristas y las agrega con union-find. O(m log m)
+ArbolMinimo arbolKruskal(const VistaCSR &grafo, const double *xs, const double *ys);
+
+// Crece el árbol desde cada vértice no alcanzado con un montículo de aristas
+ArbolMinimo arbolPrim(const VistaCSR &grafo, const double *xs, const double *ys);
+
+// En cada ronda, cada componente elige en paralelo su arista más corta hacia
+// otra y se unen todas; en O(log n) rondas queda el bosque, sin ordenar aristas
+ArbolMinimo arbolBoruvka(const VistaCSR &grafo, const double *xs, const double *ys, PoolHilos &hilos);
+
+// Kruskal para grafos chicos o con un solo hilo, Borůvka en paralelo para los grandes
+ArbolMinimo arbolMinimo(const VistaCSR &grafo, const double *xs, const double *ys, PoolHilos &hilos);
+
+#endif // ARBOLMINIMO_H
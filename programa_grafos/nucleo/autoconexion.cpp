@@ -0,0 +1,451 @@
+#include "autoconexion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include "arbolminimo.h"
+#include "grafo.h"
+#include "indiceespacial.h"
+
+namespace {
+
+const double epsilon = std::numeric_limits<double>::epsilon();
+const double infinito = std::numeric_limits<double>::infinity();
+
+// Triangulación incremental por barrido radial. Los triángulos se guardan como
+// ternas de vértices y cada lado sabe cuál es su lado gemelo en el triángulo
+// vecino (-1 en el casco convexo). El casco es una lista doblemente enlazada
+// con una tabla por ángulo para encontrar rápido la arista visible desde cada
+// punto nuevo
+class Triangulador {
+public:
+    Triangulador(const double *xs, const double *ys, int n);
+
+    std::vector<int> aristas() const;
+
+private:
+    void triangular();
+    void ordenarAlineados();
+    int agregarTriangulo(int i0, int i1, int i2, int a, int b, int c);
+    void enlazar(int a, int b);
+    int legalizar(int a);
+    int claveCasco(double x, double y) const;
+
+    // Verdadero si p, q, r giran en el sentido de los triángulos
+    bool orientados(int p, int q, int r) const
+    {
+        return (ys[q] - ys[p]) * (xs[r] - xs[q]) - (xs[q] - xs[p]) * (ys[r] - ys[q]) < 0;
+    }
+
+    // Verdadero si p está dentro del círculo que pasa por a, b y c
+    bool dentroDelCirculo(int a, int b, int c, int p) const
+    {
+        const double dx = xs[a] - xs[p], dy = ys[a] - ys[p];
+        const double ex = xs[b] - xs[p], ey = ys[b] - ys[p];
+        const double fx = xs[c] - xs[p], fy = ys[c] - ys[p];
+        const double ap = dx * dx + dy * dy, bp = ex * ex + ey * ey, cp = fx * fx + fy * fy;
+        return dx * (ey * cp - bp * fy) - dy * (ex * cp - bp * fx) + ap * (ex * fy - ey * fx) < 0;
+    }
+
+    const double *xs;
+    const double *ys;
+    int n;
+    std::vector<int> triangulos; // Vértices de cada triángulo, de a tres
+    std::vector<int> gemelos; // Lado gemelo de cada lado, o -1
+    int cantidad = 0; // Lados usados en triangulos
+    std::vector<int> cascoAnterior, cascoSiguiente; // Casco convexo; cascoSiguiente[v] == v si v salió
+    std::vector<int> cascoTriangulo; // Lado del casco que empieza en cada vértice
+    std::vector<int> tablaCasco; // Vértice del casco por ángulo alrededor del centro
+    int inicioCasco = 0;
+    double centroX = 0, centroY = 0;
+    std::vector<int> pila; // Lados pendientes de legalizar
+    std::vector<int> alineados; // Si no hay triángulos: los puntos en orden sobre su recta
+};
+
+Triangulador::Triangulador(const double *xs, const double *ys, int n) : xs(xs), ys(ys), n(n)
+{
+    if (n >= 2) {
+        triangular();
+    }
+}
+
+void Triangulador::triangular()
+{
+    double xMin = infinito, yMin = infinito, xMax = -infinito, yMax = -infinito;
+    for (int i = 0; i < n; ++i) {
+        xMin = std::min(xMin, xs[i]);
+        yMin = std::min(yMin, ys[i]);
+        xMax = std::max(xMax, xs[i]);
+        yMax = std::max(yMax, ys[i]);
+    }
+    const double cx = (xMin + xMax) / 2, cy = (yMin + yMax) / 2;
+    auto distancia2 = [](double ax, double ay, double bx, double by) {
+        return (ax - bx) * (ax - bx) + (ay - by) * (ay - by);
+    };
+
+    // Semilla: el punto más cerca del centro, su vecino más cercano y el tercero
+    // que forma con ellos el círculo más chico
+    int i0 = 0, i1 = -1, i2 = -1;
+    double minimo = infinito;
+    for (int i = 0; i < n; ++i) {
+        const double d = distancia2(cx, cy, xs[i], ys[i]);
+        if (d < minimo) {
+            i0 = i;
+            minimo = d;
+        }
+    }
+    minimo = infinito;
+    for (int i = 0; i < n; ++i) {
+        const double d = distancia2(xs[i0], ys[i0], xs[i], ys[i]);
+        if (i != i0 && d > 0 && d < minimo) {
+            i1 = i;
+            minimo = d;
+        }
+    }
+    if (i1 < 0) {
+        return; // Todos los puntos coinciden
+    }
+    minimo = infinito;
+    for (int i = 0; i < n; ++i) {
+        if (i == i0 || i == i1) {
+            continue;
+        }
+        // Cuadrado del radio del círculo por i0, i1, i (infinito o NaN si están alineados)
+        const double dx = xs[i1] - xs[i0], dy = ys[i1] - ys[i0];
+        const double ex = xs[i] - xs[i0], ey = ys[i] - ys[i0];
+        const double bl = dx * dx + dy * dy, cl = ex * ex + ey * ey;
+        const double d = 0.5 / (dx * ey - dy * ex);
+        const double x = (ey * bl - dy * cl) * d, y = (dx * cl - ex * bl) * d;
+        const double radio = x * x + y * y;
+        if (radio < minimo) {
+            i2 = i;
+            minimo = radio;
+        }
+    }
+    if (i2 < 0 || minimo == infinito) {
+        ordenarAlineados();
+        return;
+    }
+    if (orientados(i0, i1, i2)) {
+        std::swap(i1, i2); // La semilla queda en el sentido contrario al de orientados
+    }
+
+    // Centro del círculo de la semilla: los puntos se agregan por distancia a él
+    {
+        const double dx = xs[i1] - xs[i0], dy = ys[i1] - ys[i0];
+        const double ex = xs[i2] - xs[i0], ey = ys[i2] - ys[i0];
+        const double bl = dx * dx + dy * dy, cl = ex * ex + ey * ey;
+        const double d = 0.5 / (dx * ey - dy * ex);
+        centroX = xs[i0] + (ey * bl - dy * cl) * d;
+        centroY = ys[i0] + (dx * cl - ex * bl) * d;
+    }
+    std::vector<double> distancias(n);
+    for (int i = 0; i < n; ++i) {
+        distancias[i] = distancia2(xs[i], ys[i], centroX, centroY);
+    }
+    std::vector<int> orden(n);
+    std::iota(orden.begin(), orden.end(), 0);
+    std::sort(orden.begin(), orden.end(), [&](int a, int b) {
+        return distancias[a] != distancias[b] ? distancias[a] < distancias[b] : a < b;
+    });
+
+    const int maximoTriangulos = std::max(2 * n - 5, 1);
+    triangulos.resize(3 * static_cast<size_t>(maximoTriangulos));
+    gemelos.resize(3 * static_cast<size_t>(maximoTriangulos));
+    cascoAnterior.resize(n);
+    cascoSiguiente.resize(n);
+    cascoTriangulo.resize(n);
+    tablaCasco.assign(static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(n)))), -1);
+
+    inicioCasco = i0;
+    cascoSiguiente[i0] = cascoAnterior[i2] = i1;
+    cascoSiguiente[i1] = cascoAnterior[i0] = i2;
+    cascoSiguiente[i2] = cascoAnterior[i1] = i0;
+    cascoTriangulo[i0] = 0;
+    cascoTriangulo[i1] = 1;
+    cascoTriangulo[i2] = 2;
+    tablaCasco[claveCasco(xs[i0], ys[i0])] = i0;
+    tablaCasco[claveCasco(xs[i1], ys[i1])] = i1;
+    tablaCasco[claveCasco(xs[i2], ys[i2])] = i2;
+    agregarTriangulo(i0, i1, i2, -1, -1, -1);
+
+    const int tamanoTabla = static_cast<int>(tablaCasco.size());
+    double xAnterior = 0, yAnterior = 0;
+    for (int k = 0; k < n; ++k) {
+        const int i = orden[k];
+        const double x = xs[i], y = ys[i];
+        if (k > 0 && std::abs(x - xAnterior) <= epsilon && std::abs(y - yAnterior) <= epsilon) {
+            continue; // Casi coincide con el anterior: se omite
+        }
+        xAnterior = x;
+        yAnterior = y;
+        if (i == i0 || i == i1 || i == i2) {
+            continue;
+        }
+
+        // Una arista del casco visible desde i, empezando por la de ángulo parecido
+        int inicio = 0;
+        for (int j = 0, clave = claveCasco(x, y); j < tamanoTabla; ++j) {
+            inicio = tablaCasco[(clave + j) % tamanoTabla];
+            if (inicio != -1 && inicio != cascoSiguiente[inicio]) {
+                break;
+            }
+        }
+        inicio = cascoAnterior[inicio];
+        int e = inicio, q;
+        while (q = cascoSiguiente[e], !orientados(i, e, q)) {
+            e = q;
+            if (e == inicio) {
+                e = -1;
+                break;
+            }
+        }
+        if (e == -1) {
+            continue; // Prácticamente sobre el casco: se omite
+        }
+
+        // Primer triángulo con i, y luego los que se abren hacia adelante y hacia atrás
+        int t = agregarTriangulo(e, i, cascoSiguiente[e], -1, -1, cascoTriangulo[e]);
+        cascoTriangulo[i] = legalizar(t + 2);
+        cascoTriangulo[e] = t;
+        int m = cascoSiguiente[e];
+        while (q = cascoSiguiente[m], orientados(i, m, q)) {
+            t = agregarTriangulo(m, i, q, cascoTriangulo[i], -1, cascoTriangulo[m]);
+            cascoTriangulo[i] = legalizar(t + 2);
+            cascoSiguiente[m] = m; // Sale del casco
+            m = q;
+        }
+        if (e == inicio) {
+            while (q = cascoAnterior[e], orientados(i, q, e)) {
+                t = agregarTriangulo(q, i, e, -1, cascoTriangulo[e], cascoTriangulo[q]);
+                legalizar(t + 2);
+                cascoTriangulo[q] = t;
+                cascoSiguiente[e] = e;
+                e = q;
+            }
+        }
+
+        inicioCasco = cascoAnterior[i] = e;
+        cascoSiguiente[e] = cascoAnterior[m] = i;
+        cascoSiguiente[i] = m;
+        tablaCasco[claveCasco(x, y)] = i;
+        tablaCasco[claveCasco(xs[e], ys[e])] = e;
+    }
+}
+
+void Triangulador::ordenarAlineados()
+{
+    // Se ordenan por x o, si la recta es vertical, por y
+    double xMin = infinito, xMax = -infinito;
+    for (int i = 0; i < n; ++i) {
+        xMin = std::min(xMin, xs[i]);
+        xMax = std::max(xMax, xs[i]);
+    }
+    const double *clave = xMax > xMin ? xs : ys;
+    alineados.resize(n);
+    std::iota(alineados.begin(), alineados.end(), 0);
+    std::sort(alineados.begin(), alineados.end(), [&](int a, int b) {
+        return clave[a] != clave[b] ? clave[a] < clave[b] : a < b;
+    });
+}
+
+int Triangulador::agregarTriangulo(int i0, int i1, int i2, int a, int b, int c)
+{
+    const int t = cantidad;
+    triangulos[t] = i0;
+    triangulos[t + 1] = i1;
+    triangulos[t + 2] = i2;
+    enlazar(t, a);
+    enlazar(t + 1, b);
+    enlazar(t + 2, c);
+    cantidad += 3;
+    return t;
+}
+
+void Triangulador::enlazar(int a, int b)
+{
+    gemelos[a] = b;
+    if (b != -1) {
+        gemelos[b] = a;
+    }
+}
+
+int Triangulador::legalizar(int a)
+{
+    // Gira los lados que no cumplen la condición de Delaunay y revisa los que
+    // quedan expuestos, con una pila en vez de recursión
+    pila.clear();
+    int ar = 0;
+    for (;;) {
+        const int b = gemelos[a];
+        const int a0 = a - a % 3;
+        ar = a0 + (a + 2) % 3;
+        if (b == -1) {
+            if (pila.empty()) {
+                break;
+            }
+            a = pila.back();
+            pila.pop_back();
+            continue;
+        }
+
+        const int b0 = b - b % 3;
+        const int al = a0 + (a + 1) % 3;
+        const int bl = b0 + (b + 2) % 3;
+        const int p0 = triangulos[ar], pr = triangulos[a], pl = triangulos[al], p1 = triangulos[bl];
+        if (dentroDelCirculo(p0, pr, pl, p1)) {
+            triangulos[a] = p1;
+            triangulos[b] = p0;
+            const int hbl = gemelos[bl];
+            if (hbl == -1) {
+                // El lado girado estaba en el casco: se corrige la referencia del casco
+                int e = inicioCasco;
+                do {
+                    if (cascoTriangulo[e] == bl) {
+                        cascoTriangulo[e] = a;
+                        break;
+                    }
+                    e = cascoAnterior[e];
+                } while (e != inicioCasco);
+            }
+            enlazar(a, hbl);
+            enlazar(b, gemelos[ar]);
+            enlazar(ar, bl);
+            pila.push_back(b0 + (b + 1) % 3);
+        } else {
+            if (pila.empty()) {
+                break;
+            }
+            a = pila.back();
+            pila.pop_back();
+        }
+    }
+    return ar;
+}
+
+int Triangulador::claveCasco(double x, double y) const
+{
+    // Pseudoángulo en [0, 1]: crece con el ángulo sin calcular funciones trigonométricas
+    const double dx = x - centroX, dy = y - centroY;
+    const double p = dx / (std::abs(dx) + std::abs(dy));
+    const double angulo = (dy > 0 ? 3 - p : 1 + p) / 4;
+    const int tamano = static_cast<int>(tablaCasco.size());
+    return static_cast<int>(std::floor(angulo * tamano)) % tamano;
+}
+
+std::vector<int> Triangulador::aristas() const
+{
+    std::vector<int> pares;
+    if (!alineados.empty()) {
+        for (size_t i = 1; i < alineados.size(); ++i) {
+            pares.push_back(alineados[i - 1]);
+            pares.push_back(alineados[i]);
+        }
+        return pares;
+    }
+    // Cada lado interior aparece dos veces (con su gemelo); se toma una
+    pares.reserve(cantidad);
+    for (int e = 0; e < cantidad; ++e) {
+        if (e > gemelos[e]) {
+            pares.push_back(triangulos[e]);
+            pares.push_back(triangulos[e % 3 == 2 ? e - 2 : e + 1]);
+        }
+    }
+    return pares;
+}
+
+// CSR simétrica de n vértices a partir de pares a, b consecutivos
+Grafo::CSR csrDePares(int n, const std::vector<int> &pares)
+{
+    Grafo::CSR csr;
+    csr.inicio.assign(n + 1, 0);
+    for (int v : pares) {
+        ++csr.inicio[v + 1];
+    }
+    for (int v = 0; v < n; ++v) {
+        csr.inicio[v + 1] += csr.inicio[v];
+    }
+    csr.vecinos.resize(pares.size());
+    std::vector<int> siguiente(csr.inicio.begin(), csr.inicio.end() - 1);
+    for (size_t i = 0; i + 1 < pares.size(); i += 2) {
+        csr.vecinos[siguiente[pares[i]]++] = pares[i + 1];
+        csr.vecinos[siguiente[pares[i + 1]]++] = pares[i];
+    }
+    return csr;
+}
+
+} // namespace
+
+std::vector<int> triangulacionDelaunay(const double *xs, const double *ys, int n)
+{
+    return Triangulador(xs, ys, n).aristas();
+}
+
+std::vector<int> arbolEuclidiano(const double *xs, const double *ys, int n)
+{
+    const Grafo::CSR csr = csrDePares(n, triangulacionDelaunay(xs, ys, n));
+    return arbolKruskal(csr.vista(), xs, ys).aristas;
+}
+
+std::vector<int> vecinosMasCercanos(const double *xs, const double *ys, int n, int k)
+{
+    std::vector<int> pares;
+    k = std::min(k, n - 1);
+    if (k <= 0) {
+        return pares;
+    }
+
+    // Celdas en las que caen unos k puntos si están repartidos de forma pareja
+    double xMin = infinito, yMin = infinito, xMax = -infinito, yMax = -infinito;
+    for (int i = 0; i < n; ++i) {
+        xMin = std::min(xMin, xs[i]);
+        yMin = std::min(yMin, ys[i]);
+        xMax = std::max(xMax, xs[i]);
+        yMax = std::max(yMax, ys[i]);
+    }
+    const double ancho = xMax - xMin, alto = yMax - yMin;
+    // Con todos los puntos casi en el mismo lugar el lado se acota por la
+    // escala de las coordenadas, así ninguna queda a más de 1e9 celdas del origen
+    const double escala = std::max({std::abs(xMin), std::abs(xMax), std::abs(yMin), std::abs(yMax)});
+    const double minimo = escala > 0 ? escala * 1e-9 : 1.0;
+    const double lado = std::max({std::sqrt(ancho * alto * k / n), std::max(ancho, alto) * k / n, minimo});
+    IndiceEspacial indice(lado);
+    for (int i = 0; i < n; ++i) {
+        indice.insertar(i, xs[i], ys[i]);
+    }
+
+    std::vector<int> candidatos;
+    std::vector<std::pair<double, int>> cercanos;
+    pares.reserve(2 * static_cast<size_t>(n) * k);
+    for (int v = 0; v < n; ++v) {
+        // Se agranda el cuadrado hasta que el círculo inscrito tenga k puntos (o
+        // el cuadrado los tenga a todos): fuera de él no puede haber uno más cercano
+        for (double radio = lado;; radio *= 2) {
+            candidatos.clear();
+            indice.consultar(xs[v] - radio, ys[v] - radio, xs[v] + radio, ys[v] + radio, candidatos);
+            cercanos.clear();
+            int dentro = 0;
+            for (int w : candidatos) {
+                if (w == v) {
+                    continue;
+                }
+                const double dx = xs[w] - xs[v], dy = ys[w] - ys[v];
+                const double d2 = dx * dx + dy * dy;
+                cercanos.emplace_back(d2, w);
+                dentro += d2 <= radio * radio;
+            }
+            if (dentro >= k || static_cast<int>(candidatos.size()) == n) {
+                break;
+            }
+        }
+        std::partial_sort(cercanos.begin(), cercanos.begin() + k, cercanos.end());
+        for (int j = 0; j < k; ++j) {
+            pares.push_back(v);
+            pares.push_back(cercanos[j].second);
+        }
+    }
+    return pares;
+}
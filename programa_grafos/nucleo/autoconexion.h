@@ -0,0 +1,24 @@
+#ifndef AUTOCONEXION_H
+#define AUTOCONEXION_H
+
+#include <vector>
+
+// Formas de conectar un conjunto de puntos sin crear la clique completa.
+// Todas trabajan solo con las posiciones (xs[i], ys[i], 0 <= i < n) y
+// devuelven pares i, j consecutivos de índices en esos arreglos
+
+// Triangulación de Delaunay por barrido radial (como Delaunator): los puntos
+// se agregan en orden de distancia a un triángulo semilla y se corrigen con
+// giros de aristas. O(n log n). Si todos están alineados devuelve el camino
+// que los une en orden
+std::vector<int> triangulacionDelaunay(const double *xs, const double *ys, int n);
+
+// Árbol de expansión mínima euclidiano: está contenido en la triangulación de
+// Delaunay, así que basta con Kruskal sobre sus O(n) aristas
+std::vector<int> arbolEuclidiano(const double *xs, const double *ys, int n);
+
+// Une cada punto con sus k vecinos más cercanos, buscados en una rejilla
+// uniforme con celdas del tamaño de la separación media entre puntos
+std::vector<int> vecinosMasCercanos(const double *xs, const double *ys, int n, int k);
+
+#endif // AUTOCONEXION_H
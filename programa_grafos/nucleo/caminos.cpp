@@ -0,0 +1,174 @@
+#include "caminos.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const double infinito = std::numeric_limits<double>::infinity();
+
+double largo(const double *xs, const double *ys, int a, int b)
+{
+    const double dx = xs[a] - xs[b], dy = ys[a] - ys[b];
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+} // namespace
+
+double BuscadorCaminos::caminoMasCorto(const VistaCSR &grafo, const double *xs, const double *ys, int origen,
+                                       int destino)
+{
+    if (destino < 0 || destino >= grafo.n) {
+        preparar(grafo.n); // Deja la consulta vacía
+        visitados = 0;
+        return infinito;
+    }
+    return buscar(grafo, xs, ys, origen, destino);
+}
+
+void BuscadorCaminos::distanciasDesde(const VistaCSR &grafo, const double *xs, const double *ys, int origen)
+{
+    buscar(grafo, xs, ys, origen, -1);
+}
+
+double BuscadorCaminos::distancia(int v) const
+{
+    return vigente(v) ? distancias[v] : infinito;
+}
+
+void BuscadorCaminos::camino(int destino, std::vector<int> &salida) const
+{
+    salida.clear();
+    if (destino < 0 || !vigente(destino)) {
+        return;
+    }
+    for (int v = destino; v >= 0; v = previos[v]) {
+        salida.push_back(v);
+    }
+    std::reverse(salida.begin(), salida.end());
+}
+
+double BuscadorCaminos::buscar(const VistaCSR &grafo, const double *xs, const double *ys, int origen, int destino)
+{
+    preparar(grafo.n);
+    visitados = 0;
+    if (origen < 0 || origen >= grafo.n) {
+        return infinito;
+    }
+
+    // Con destino, la distancia en línea recta nunca sobreestima (las aristas
+    // miden lo mismo), así que A* cierra cada vértice una sola vez; sin
+    // destino la heurística es 0 y queda Dijkstra
+    auto heuristica = [&](int v) { return destino >= 0 ? largo(xs, ys, v, destino) : 0.0; };
+
+    marcas[origen] = generacion;
+    distancias[origen] = 0;
+    previos[origen] = -1;
+    prioridades[origen] = heuristica(origen);
+    insertar(origen);
+    while (!monticulo.empty()) {
+        const int v = extraerMinimo();
+        ++visitados;
+        if (v == destino) {
+            return distancias[v];
+        }
+        for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+            const int w = grafo.vecinos[k];
+            const double d = distancias[v] + largo(xs, ys, v, w);
+            if (marcas[w] != generacion) {
+                // Primera vez que la consulta toca w
+                marcas[w] = generacion;
+                distancias[w] = d;
+                previos[w] = v;
+                prioridades[w] = d + heuristica(w);
+                insertar(w);
+            } else if (posiciones[w] >= 0 && d < distancias[w]) {
+                // Sigue abierto y se encontró un camino mejor: sube en el montículo
+                distancias[w] = d;
+                prioridades[w] = d + heuristica(w);
+                previos[w] = v;
+                subir(posiciones[w]);
+            }
+        }
+    }
+    return destino >= 0 ? infinito : 0;
+}
+
+void BuscadorCaminos::preparar(int n)
+{
+    if (static_cast<int>(marcas.size()) < n) {
+        distancias.resize(n);
+        prioridades.resize(n);
+        previos.resize(n);
+        posiciones.resize(n);
+        marcas.resize(n, 0);
+        monticulo.reserve(n); // Cada vértice entra a lo sumo una vez
+    }
+    monticulo.clear();
+    if (++generacion == 0) {
+        // Tras 2^32 consultas las marcas viejas podrían coincidir: se borran
+        std::fill(marcas.begin(), marcas.end(), 0);
+        generacion = 1;
+    }
+}
+
+void BuscadorCaminos::insertar(int v)
+{
+    monticulo.push_back(v);
+    posiciones[v] = static_cast<int>(monticulo.size()) - 1;
+    subir(posiciones[v]);
+}
+
+void BuscadorCaminos::subir(int i)
+{
+    const int v = monticulo[i];
+    const double clave = prioridades[v];
+    while (i > 0) {
+        const int padre = (i - 1) / 2;
+        if (prioridades[monticulo[padre]] <= clave) {
+            break;
+        }
+        monticulo[i] = monticulo[padre];
+        posiciones[monticulo[i]] = i;
+        i = padre;
+    }
+    monticulo[i] = v;
+    posiciones[v] = i;
+}
+
+void BuscadorCaminos::bajar(int i)
+{
+    const int n = static_cast<int>(monticulo.size());
+    const int v = monticulo[i];
+    const double clave = prioridades[v];
+    for (;;) {
+        int hijo = 2 * i + 1;
+        if (hijo >= n) {
+            break;
+        }
+        if (hijo + 1 < n && prioridades[monticulo[hijo + 1]] < prioridades[monticulo[hijo]]) {
+            ++hijo;
+        }
+        if (prioridades[monticulo[hijo]] >= clave) {
+            break;
+        }
+        monticulo[i] = monticulo[hijo];
+        posiciones[monticulo[i]] = i;
+        i = hijo;
+    }
+    monticulo[i] = v;
+    posiciones[v] = i;
+}
+
+int BuscadorCaminos::extraerMinimo()
+{
+    const int minimo = monticulo.front();
+    monticulo.front() = monticulo.back();
+    monticulo.pop_back();
+    if (!monticulo.empty()) {
+        bajar(0);
+    }
+    posiciones[minimo] = -1; // Cerrado
+    return minimo;
+}
@@ -0,0 +1,57 @@
+#ifndef CAMINOS_H
+#define CAMINOS_H
+
+#include <cstdint>
+#include <vector>
+
+#include "grafo.h"
+
+// Caminos más cortos sobre la adyacencia CSR, donde el peso de cada arista es
+// la distancia euclidiana entre las posiciones de sus extremos. Un mismo
+// buscador sirve para muchas consultas seguidas: los arreglos se conservan y
+// una marca de generación indica qué casillas pertenecen a la consulta
+// actual, así que después de la primera consulta no se reserva memoria
+// (salvo que el grafo crezca)
+class BuscadorCaminos {
+public:
+    // A* de origen a destino, con la distancia en línea recta como heurística.
+    // Devuelve la longitud del camino, o infinito si no hay ninguno
+    double caminoMasCorto(const VistaCSR &grafo, const double *xs, const double *ys, int origen, int destino);
+
+    // Dijkstra desde origen hasta todos los vértices alcanzables
+    void distanciasDesde(const VistaCSR &grafo, const double *xs, const double *ys, int origen);
+
+    // Distancia de origen a v en la última consulta (infinito si no se alcanzó).
+    // Tras caminoMasCorto solo es exacta para los vértices ya cerrados
+    double distancia(int v) const;
+
+    // Vértices del camino de la última consulta hasta destino, desde el origen;
+    // queda vacío si destino no se alcanzó
+    void camino(int destino, std::vector<int> &salida) const;
+
+    // Cantidad de vértices cerrados en la última consulta
+    int verticesVisitados() const { return visitados; }
+
+private:
+    double buscar(const VistaCSR &grafo, const double *xs, const double *ys, int origen, int destino);
+    void preparar(int n);
+    bool vigente(int v) const { return v < static_cast<int>(marcas.size()) && marcas[v] == generacion; }
+
+    // Montículo binario indexado por vértice: posiciones[v] dice dónde está v
+    // en el montículo (-1 si ya se cerró), para poder bajar su prioridad en el lugar
+    void insertar(int v);
+    void subir(int i);
+    void bajar(int i);
+    int extraerMinimo();
+
+    std::vector<double> distancias; // Mejor distancia conocida desde el origen
+    std::vector<double> prioridades; // Distancia más la heurística, clave del montículo
+    std::vector<int> previos; // Vértice anterior en el mejor camino conocido
+    std::vector<int> posiciones; // Índice de cada vértice en el montículo
+    std::vector<std::uint32_t> marcas; // Generación en que se tocó cada vértice por última vez
+    std::vector<int> monticulo; // Vértices abiertos
+    std::uint32_t generacion = 0;
+    int visitados = 0;
+};
+
+#endif // CAMINOS_H
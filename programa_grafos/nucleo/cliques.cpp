@@ -0,0 +1,640 @@
+#include "cliques.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include "vectorial.h"
+
+namespace {
+
+const int limiteDenso = 8192; // Un complemento denso de 8192 vértices ocupa 8 MiB
+
+// Posición del bit en 1 más bajo; palabra no puede ser 0
+int primerBit(std::uint64_t palabra)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(palabra);
+#else
+    int bit = 0;
+    while (!(palabra & 1)) {
+        palabra >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+// Indica si un conjunto de bits no tiene ningún 1; corta en la primera palabra no vacía
+bool vacio(const std::uint64_t *conjunto, int palabras)
+{
+    for (int k = 0; k < palabras; ++k) {
+        if (conjunto[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Búsqueda de una clique máxima sobre un grafo chico guardado como matriz de
+// bits: la fila de cada vértice tiene un bit por vecino. Es Bron–Kerbosch sin
+// el conjunto de excluidos (solo interesa la mayor) y, en lugar del pivote, se
+// ramifica en el orden de un coloreo voraz de los candidatos, que además da la
+// cota para podar (Tomita, San Segundo). Los candidatos de cada nivel son
+// bitsets en una pila con una fila por nivel, así que buscar casi no reserva memoria
+class BusquedaClique {
+    // Vértices por los que se ramifica en un nivel, con su color
+    struct Ramas {
+        std::vector<int> vertices;
+        std::vector<int> colores;
+    };
+
+public:
+    // Deja n vértices sin aristas, reutilizando la memoria de la búsqueda anterior
+    void preparar(int n)
+    {
+        this->n = n;
+        palabras = (n + 63) / 64;
+        adyacencia.assign(static_cast<size_t>(n) * palabras, 0);
+        pila.resize(static_cast<size_t>(n + 2) * palabras);
+        if (static_cast<int>(ramasPorNivel.size()) < n + 2) {
+            ramasPorNivel.resize(n + 2); // Las listas conservan su capacidad entre búsquedas
+        }
+        restantes.resize(palabras);
+        clase.resize(palabras);
+    }
+
+    void conectar(int a, int b)
+    {
+        fila(a)[b / 64] |= std::uint64_t(1) << (b % 64);
+        fila(b)[a / 64] |= std::uint64_t(1) << (a % 64);
+    }
+
+    // Todos unidos con todos, salvo cada uno consigo mismo
+    void completar()
+    {
+        for (int v = 0; v < n; ++v) {
+            std::uint64_t *f = fila(v);
+            std::fill(f, f + palabras, ~std::uint64_t(0));
+            if (n % 64) {
+                f[palabras - 1] = (std::uint64_t(1) << (n % 64)) - 1; // Sin bits fuera del rango
+            }
+            f[v / 64] &= ~(std::uint64_t(1) << (v % 64));
+        }
+    }
+
+    void desconectar(int a, int b)
+    {
+        fila(a)[b / 64] &= ~(std::uint64_t(1) << (b % 64));
+        fila(b)[a / 64] &= ~(std::uint64_t(1) << (a % 64));
+    }
+
+    // Busca una clique de más de minimo vértices y devuelve la mayor que
+    // encontró (vacía si ninguna supera minimo). Cada nodo visitado descuenta
+    // uno de presupuesto; si llega a 0 la búsqueda se corta
+    std::vector<int> buscar(int minimo, long long &presupuesto)
+    {
+        mejor.clear();
+        mejorTamano = minimo;
+        actual.clear();
+        cortada = false;
+        this->presupuesto = &presupuesto;
+        std::uint64_t *todos = pila.data();
+        std::fill(todos, todos + palabras, ~std::uint64_t(0));
+        if (n % 64) {
+            todos[palabras - 1] = (std::uint64_t(1) << (n % 64)) - 1;
+        }
+        if (n > 0) {
+            expandir(0);
+        }
+        return mejor;
+    }
+
+    bool fueCortada() const { return cortada; }
+
+private:
+    std::uint64_t *fila(int v) { return adyacencia.data() + static_cast<size_t>(v) * palabras; }
+
+    // Colorea de forma voraz los candidatos (clases de vértices no vecinos
+    // entre sí, tomados en orden de índice) y deja en ramas del nivel los que
+    // tienen color mayor que minimo, ordenados por color. Una clique no puede
+    // tener dos vértices del mismo color, así que entre los candidatos con
+    // color k o menor no hay ninguna de más de k vértices
+    void colorear(const std::uint64_t *candidatos, int minimo, Ramas &salida)
+    {
+        salida.vertices.clear();
+        salida.colores.clear();
+        std::copy(candidatos, candidatos + palabras, restantes.begin());
+        int colorActual = 0;
+        for (int inicio = 0; inicio < palabras;) {
+            if (!restantes[inicio]) {
+                ++inicio;
+                continue;
+            }
+            ++colorActual;
+            std::copy(restantes.begin(), restantes.end(), clase.begin());
+            for (int w = inicio; w < palabras; ++w) {
+                while (clase[w]) {
+                    const int v = w * 64 + primerBit(clase[w]);
+                    const std::uint64_t bit = std::uint64_t(1) << (v % 64);
+                    restantes[w] &= ~bit;
+                    clase[w] &= ~bit;
+                    const std::uint64_t *vecinos = fila(v);
+                    for (int k = w; k < palabras; ++k) {
+                        clase[k] &= ~vecinos[k];
+                    }
+                    if (colorActual > minimo) {
+                        salida.vertices.push_back(v);
+                        salida.colores.push_back(colorActual);
+                    }
+                }
+            }
+        }
+    }
+
+    void expandir(int nivel)
+    {
+        if (*presupuesto <= 0) {
+            cortada = true;
+            return;
+        }
+        --*presupuesto;
+        std::uint64_t *candidatos = pila.data() + static_cast<size_t>(nivel) * palabras;
+        std::uint64_t *siguientes = candidatos + palabras;
+        const int tamano = static_cast<int>(actual.size());
+        if (vacio(candidatos, palabras)) {
+            if (tamano > mejorTamano) {
+                mejor = actual;
+                mejorTamano = tamano;
+            }
+            return;
+        }
+
+        // Se ramifica desde el color más alto; los de color bajo solo siguen como candidatos
+        Ramas &ramas = ramasPorNivel[nivel];
+        colorear(candidatos, mejorTamano - tamano, ramas);
+        for (int i = static_cast<int>(ramas.vertices.size()) - 1; i >= 0; --i) {
+            if (tamano + ramas.colores[i] <= mejorTamano) {
+                return; // mejorTamano pudo crecer en una rama anterior
+            }
+            const int v = ramas.vertices[i];
+            const std::uint64_t *vecinos = fila(v);
+            // Una clique con v no pasa de v más sus vecinos entre los candidatos; con
+            // el color solo se acota por todos los candidatos de color menor
+            if (tamano + 1 + contarComunes(candidatos, vecinos, palabras) > mejorTamano) {
+                for (int k = 0; k < palabras; ++k) {
+                    siguientes[k] = candidatos[k] & vecinos[k];
+                }
+                actual.push_back(v);
+                expandir(nivel + 1);
+                actual.pop_back();
+                if (cortada) {
+                    return;
+                }
+            }
+            candidatos[v / 64] &= ~(std::uint64_t(1) << (v % 64)); // Las cliques con v ya se revisaron
+        }
+    }
+
+    int n = 0;
+    int palabras = 0;
+    std::vector<std::uint64_t> adyacencia; // n filas de palabras
+    std::vector<std::uint64_t> pila; // Candidatos de cada nivel
+    std::vector<Ramas> ramasPorNivel;
+    std::vector<std::uint64_t> restantes, clase; // Para colorear
+    std::vector<int> actual; // Clique que se está armando
+    std::vector<int> mejor; // Mayor clique encontrada de más de mejorTamano vértices
+    int mejorTamano = 0;
+    long long *presupuesto = nullptr;
+    bool cortada = false;
+};
+
+// Orden de degeneración: se quita siempre el vértice de menor grado restante,
+// con cubetas por grado. Cada vértice queda con pocos vecinos posteriores
+std::vector<int> ordenDegeneracion(const VistaCSR &grafo)
+{
+    const int n = grafo.n;
+    std::vector<int> grado(n);
+    int gradoMaximo = 0;
+    for (int v = 0; v < n; ++v) {
+        grado[v] = grafo.inicio[v + 1] - grafo.inicio[v];
+        gradoMaximo = std::max(gradoMaximo, grado[v]);
+    }
+    // Vértices ordenados por grado; inicioCubeta[g] es donde empiezan los de grado g
+    std::vector<int> inicioCubeta(gradoMaximo + 2, 0);
+    for (int v = 0; v < n; ++v) {
+        ++inicioCubeta[grado[v] + 1];
+    }
+    for (int g = 0; g <= gradoMaximo; ++g) {
+        inicioCubeta[g + 1] += inicioCubeta[g];
+    }
+    std::vector<int> orden(n), posicion(n);
+    {
+        std::vector<int> siguiente(inicioCubeta.begin(), inicioCubeta.end() - 1);
+        for (int v = 0; v < n; ++v) {
+            posicion[v] = siguiente[grado[v]]++;
+            orden[posicion[v]] = v;
+        }
+    }
+    // Al quitar v, cada vecino que sigue adentro baja una cubeta: se cambia de
+    // lugar con el primero de la suya y la cubeta empieza uno después
+    for (int i = 0; i < n; ++i) {
+        const int v = orden[i];
+        for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+            const int w = grafo.vecinos[k];
+            if (grado[w] > grado[v]) {
+                const int primero = inicioCubeta[grado[w]];
+                const int u = orden[primero];
+                std::swap(orden[primero], orden[posicion[w]]);
+                std::swap(posicion[u], posicion[w]);
+                ++inicioCubeta[grado[w]];
+                --grado[w];
+            }
+        }
+    }
+    return orden;
+}
+
+// Reducciones exactas para el conjunto independiente máximo, sobre listas de
+// adyacencia que se pueden modificar. Un vértice de grado 0 o 1 se toma; uno
+// de grado 2 con sus vecinos unidos también; uno de grado 2 con vecinos u, w
+// no unidos se pliega: v, u y w se cambian por un vértice nuevo con los
+// vecinos de u y w, y α baja en uno (al desplegar se toman u y w si el nuevo
+// quedó en el conjunto, y v si no). Si N[v] está contenido en N[u] para un
+// vecino u, hay un máximo sin u y u se quita (dominación)
+class ReduccionIndependiente {
+    // Pliegue de v con sus vecinos u y w en el vértice z
+    struct Pliegue {
+        int v, u, w, z;
+    };
+
+public:
+    explicit ReduccionIndependiente(const VistaCSR &grafo)
+        : adyacencia(grafo.n), grado(grafo.n), vivo(grafo.n, 1), marca(grafo.n, 0)
+    {
+        for (int v = 0; v < grafo.n; ++v) {
+            adyacencia[v].assign(grafo.vecinos + grafo.inicio[v], grafo.vecinos + grafo.inicio[v + 1]);
+            grado[v] = static_cast<int>(adyacencia[v].size());
+            pendientes.push_back(v);
+        }
+    }
+
+    // Aplica las reducciones hasta que ninguna cambie nada
+    void reducir()
+    {
+        while (!pendientes.empty()) {
+            const int v = pendientes.back();
+            pendientes.pop_back();
+            if (!vivo[v]) {
+                continue;
+            }
+            if (grado[v] <= 1) {
+                tomar(v);
+            } else if (grado[v] == 2) {
+                int u = -1, w = -1;
+                for (int x : adyacencia[v]) {
+                    if (vivo[x]) {
+                        (u < 0 ? u : w) = x;
+                    }
+                }
+                if (unidos(u, w)) {
+                    tomar(v);
+                } else {
+                    plegar(v, u, w);
+                }
+            } else {
+                quitarDominados(v);
+            }
+        }
+    }
+
+    // El grafo que queda, con los vértices vivos numerados desde 0; id[i] es
+    // el vértice (original o de un pliegue) que corresponde a i
+    Grafo::CSR nucleo(std::vector<int> &id) const
+    {
+        const int total = static_cast<int>(adyacencia.size());
+        std::vector<int> local(total, -1);
+        id.clear();
+        for (int v = 0; v < total; ++v) {
+            if (vivo[v]) {
+                local[v] = static_cast<int>(id.size());
+                id.push_back(v);
+            }
+        }
+        Grafo::CSR csr;
+        csr.inicio.assign(1, 0);
+        for (int v : id) {
+            for (int x : adyacencia[v]) {
+                if (vivo[x]) {
+                    csr.vecinos.push_back(local[x]);
+                }
+            }
+            csr.inicio.push_back(static_cast<int>(csr.vecinos.size()));
+        }
+        return csr;
+    }
+
+    // Completa un conjunto elegido entre los vértices del núcleo con los
+    // tomados al reducir, deshace los pliegues del último al primero y
+    // devuelve los vértices originales
+    std::vector<int> desplegar(const std::vector<int> &elegidos, int n) const
+    {
+        std::vector<char> dentro(adyacencia.size(), 0);
+        for (int v : elegidos) {
+            dentro[v] = 1;
+        }
+        for (int v : tomados) {
+            dentro[v] = 1;
+        }
+        for (auto it = pliegues.rbegin(); it != pliegues.rend(); ++it) {
+            if (dentro[it->z]) {
+                dentro[it->z] = 0;
+                dentro[it->u] = dentro[it->w] = 1;
+            } else {
+                dentro[it->v] = 1;
+            }
+        }
+        std::vector<int> conjunto;
+        for (int v = 0; v < n; ++v) {
+            if (dentro[v]) {
+                conjunto.push_back(v);
+            }
+        }
+        return conjunto;
+    }
+
+private:
+    void quitar(int v)
+    {
+        vivo[v] = 0;
+        for (int x : adyacencia[v]) {
+            if (vivo[x]) {
+                --grado[x];
+                pendientes.push_back(x);
+            }
+        }
+    }
+
+    void tomar(int v)
+    {
+        tomados.push_back(v);
+        for (int x : adyacencia[v]) {
+            if (vivo[x]) {
+                quitar(x);
+            }
+        }
+        quitar(v);
+    }
+
+    bool unidos(int a, int b) const
+    {
+        const int desde = grado[a] <= grado[b] ? a : b;
+        const int hasta = desde == a ? b : a;
+        for (int x : adyacencia[desde]) {
+            if (x == hasta && vivo[x]) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void plegar(int v, int u, int w)
+    {
+        const int z = static_cast<int>(adyacencia.size());
+        ++sello;
+        marca[v] = sello;
+        std::vector<int> vecinos;
+        for (int extremo : {u, w}) {
+            for (int x : adyacencia[extremo]) {
+                if (vivo[x] && marca[x] != sello) {
+                    marca[x] = sello;
+                    vecinos.push_back(x);
+                }
+            }
+        }
+        quitar(v);
+        quitar(u);
+        quitar(w);
+        for (int x : vecinos) {
+            adyacencia[x].push_back(z);
+            ++grado[x];
+        }
+        grado.push_back(static_cast<int>(vecinos.size()));
+        adyacencia.push_back(std::move(vecinos));
+        vivo.push_back(1);
+        marca.push_back(0);
+        pendientes.push_back(z);
+        pliegues.push_back({v, u, w, z});
+    }
+
+    // Quita los vecinos u de v con N[v] contenido en N[u]. Se revisan solo los
+    // de grado acotado para que un vértice muy conectado no cueste el cuadrado
+    void quitarDominados(int v)
+    {
+        ++sello;
+        marca[v] = sello;
+        for (int x : adyacencia[v]) {
+            if (vivo[x]) {
+                marca[x] = sello;
+            }
+        }
+        for (int u : adyacencia[v]) {
+            if (!vivo[u] || grado[u] < grado[v] || grado[u] > limiteDominacion) {
+                continue;
+            }
+            int comunes = 0; // Vecinos de u en N[v], incluido v
+            for (int x : adyacencia[u]) {
+                comunes += vivo[x] && marca[x] == sello;
+            }
+            if (comunes == grado[v]) {
+                quitar(u); // Deja a v pendiente, que pudo quedar con grado 2 o menos
+            }
+        }
+    }
+
+    static const int limiteDominacion = 256;
+
+    std::vector<std::vector<int>> adyacencia; // Puede tener vértices ya quitados
+    std::vector<int> grado; // Vecinos vivos
+    std::vector<char> vivo;
+    std::vector<int> marca; // Para marcar vecindarios sin limpiar entre usos
+    int sello = 0;
+    std::vector<int> pendientes; // Vértices cuyo vecindario cambió
+    std::vector<int> tomados;
+    std::vector<Pliegue> pliegues;
+};
+
+long long presupuestoInicial(long long limiteNodos)
+{
+    return limiteNodos > 0 ? limiteNodos : std::numeric_limits<long long>::max();
+}
+
+// Agrega de forma voraz vértices de la componente, de menor a mayor grado,
+// mientras no estén ya tomados ni tengan un vecino tomado
+void completarVoraz(const VistaCSR &grafo, std::vector<int> componente, std::vector<char> &tomado,
+                    std::vector<int> &conjunto)
+{
+    std::sort(componente.begin(), componente.end(), [&](int a, int b) {
+        const int ga = grafo.inicio[a + 1] - grafo.inicio[a], gb = grafo.inicio[b + 1] - grafo.inicio[b];
+        return ga != gb ? ga < gb : a < b;
+    });
+    for (int v : componente) {
+        bool libre = !tomado[v];
+        for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1] && libre; ++k) {
+            libre = !tomado[grafo.vecinos[k]];
+        }
+        if (libre) {
+            tomado[v] = 1;
+            conjunto.push_back(v);
+        }
+    }
+}
+
+} // namespace
+
+ConjuntoMaximo cliqueMaxima(const VistaCSR &grafo, long long limiteNodos)
+{
+    ConjuntoMaximo resultado;
+    const int n = grafo.n;
+    if (n == 0) {
+        return resultado;
+    }
+    resultado.vertices = {0}; // Cualquier vértice solo es una clique
+    long long presupuesto = presupuestoInicial(limiteNodos);
+
+    const std::vector<int> orden = ordenDegeneracion(grafo);
+    std::vector<int> posicion(n), local(n, -1), posteriores;
+    for (int i = 0; i < n; ++i) {
+        posicion[orden[i]] = i;
+    }
+    BusquedaClique busqueda;
+    // Desde el final del orden: los últimos forman el núcleo más denso, con
+    // subproblemas chicos que dan pronto una buena clique para podar los demás
+    for (auto it = orden.rbegin(); it != orden.rend(); ++it) {
+        const int v = *it;
+        // Las cliques cuyo primer vértice en el orden es v: v y sus vecinos posteriores
+        posteriores.clear();
+        for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+            if (posicion[grafo.vecinos[k]] > posicion[v]) {
+                posteriores.push_back(grafo.vecinos[k]);
+            }
+        }
+        const int tamano = static_cast<int>(posteriores.size());
+        if (tamano + 1 <= static_cast<int>(resultado.vertices.size())) {
+            continue; // Ni con todos se supera la mejor
+        }
+        // De mayor a menor grado: el coloreo en orden de índice da así menos colores
+        std::sort(posteriores.begin(), posteriores.end(), [&](int a, int b) {
+            const int ga = grafo.inicio[a + 1] - grafo.inicio[a], gb = grafo.inicio[b + 1] - grafo.inicio[b];
+            return ga != gb ? ga > gb : a < b;
+        });
+        for (int i = 0; i < tamano; ++i) {
+            local[posteriores[i]] = i;
+        }
+        busqueda.preparar(tamano);
+        for (int i = 0; i < tamano; ++i) {
+            const int w = posteriores[i];
+            for (int k = grafo.inicio[w]; k < grafo.inicio[w + 1]; ++k) {
+                const int j = local[grafo.vecinos[k]];
+                if (j > i) {
+                    busqueda.conectar(i, j);
+                }
+            }
+        }
+        const std::vector<int> encontrada = busqueda.buscar(static_cast<int>(resultado.vertices.size()) - 1, presupuesto);
+        if (!encontrada.empty()) {
+            resultado.vertices = {v};
+            for (int i : encontrada) {
+                resultado.vertices.push_back(posteriores[i]);
+            }
+        }
+        for (int w : posteriores) {
+            local[w] = -1;
+        }
+        if (busqueda.fueCortada()) {
+            resultado.exacto = false;
+            break;
+        }
+    }
+    std::sort(resultado.vertices.begin(), resultado.vertices.end());
+    return resultado;
+}
+
+ConjuntoMaximo conjuntoIndependienteMaximo(const VistaCSR &grafo, long long limiteNodos)
+{
+    ConjuntoMaximo resultado;
+    long long presupuesto = presupuestoInicial(limiteNodos);
+    ReduccionIndependiente reduccion(grafo);
+    reduccion.reducir();
+    std::vector<int> id;
+    const Grafo::CSR csrNucleo = reduccion.nucleo(id);
+    const VistaCSR nucleo = csrNucleo.vista();
+    const int n = nucleo.n;
+    std::vector<char> tomado(n, 0);
+    std::vector<int> elegidos; // Vértices del núcleo
+
+    // Lo que queda se resuelve por componente, con la clique máxima del complemento
+    BusquedaClique busqueda;
+    std::vector<int> componente, local(n, -1);
+    std::vector<char> visto(n, 0);
+    for (int inicio = 0; inicio < n; ++inicio) {
+        if (visto[inicio]) {
+            continue;
+        }
+        componente.assign(1, inicio);
+        visto[inicio] = 1;
+        for (size_t i = 0; i < componente.size(); ++i) {
+            const int v = componente[i];
+            for (int k = nucleo.inicio[v]; k < nucleo.inicio[v + 1]; ++k) {
+                const int w = nucleo.vecinos[k];
+                if (!visto[w]) {
+                    visto[w] = 1;
+                    componente.push_back(w);
+                }
+            }
+        }
+
+        const int tamano = static_cast<int>(componente.size());
+        if (tamano > limiteDenso || presupuesto <= 0) {
+            completarVoraz(nucleo, componente, tomado, elegidos);
+            resultado.exacto = false;
+            continue;
+        }
+        // De menor a mayor grado, que es de mayor a menor en el complemento
+        std::sort(componente.begin(), componente.end(), [&](int a, int b) {
+            const int ga = nucleo.inicio[a + 1] - nucleo.inicio[a], gb = nucleo.inicio[b + 1] - nucleo.inicio[b];
+            return ga != gb ? ga < gb : a < b;
+        });
+        for (int i = 0; i < tamano; ++i) {
+            local[componente[i]] = i;
+        }
+        busqueda.preparar(tamano);
+        busqueda.completar();
+        for (int i = 0; i < tamano; ++i) {
+            const int v = componente[i];
+            for (int k = nucleo.inicio[v]; k < nucleo.inicio[v + 1]; ++k) {
+                const int j = local[nucleo.vecinos[k]];
+                if (j >= 0) {
+                    busqueda.desconectar(i, j);
+                }
+            }
+        }
+        // Aun cortada, la búsqueda devuelve un conjunto independiente válido
+        for (int i : busqueda.buscar(0, presupuesto)) {
+            tomado[componente[i]] = 1;
+            elegidos.push_back(componente[i]);
+        }
+        if (busqueda.fueCortada()) {
+            completarVoraz(nucleo, componente, tomado, elegidos); // Que al menos sea maximal
+            resultado.exacto = false;
+        }
+        for (int v : componente) {
+            local[v] = -1;
+        }
+    }
+    for (int &v : elegidos) {
+        v = id[v];
+    }
+    resultado.vertices = reduccion.desplegar(elegidos, grafo.n);
+    return resultado;
+}
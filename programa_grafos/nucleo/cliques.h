@@ -0,0 +1,32 @@
+#ifndef CLIQUES_H
+#define CLIQUES_H
+
+#include <vector>
+
+#include "grafo.h"
+
+// Resultado de una búsqueda exacta que se puede cortar por tiempo
+struct ConjuntoMaximo {
+    std::vector<int> vertices; // Ordenados por id
+    bool exacto = true; // Falso si se agotó el límite de nodos: puede haber uno mayor
+};
+
+// Clique máxima: el mayor conjunto de vértices unidos todos entre sí. Cada
+// vértice se busca junto con sus vecinos posteriores en el orden de
+// degeneración, así que cada subproblema tiene a lo sumo tantos vértices como
+// la degeneración del grafo aunque este sea enorme. Dentro de cada uno se
+// ramifica y poda con un coloreo voraz de los candidatos, sobre vecindarios
+// guardados como bitsets que se intersecan de a 64 vértices por operación.
+// limiteNodos acota los nodos del árbol de búsqueda (0: sin límite)
+ConjuntoMaximo cliqueMaxima(const VistaCSR &grafo, long long limiteNodos = 0);
+
+// Conjunto independiente máximo: el mayor conjunto de vértices sin aristas
+// entre sí, que es una clique máxima del complemento. Primero se reduce el
+// grafo sin perder exactitud (grados 0, 1 y 2, con pliegue de los de grado 2,
+// y vértices dominados), que en grafos ralos suele dejar poco, y el resto se
+// resuelve por componente sobre el complemento denso. Las componentes de más
+// de 8192 vértices, o las que quedan al agotarse el límite, se completan de
+// forma voraz y el resultado deja de ser exacto
+ConjuntoMaximo conjuntoIndependienteMaximo(const VistaCSR &grafo, long long limiteNodos = 0);
+
+#endif // CLIQUES_H
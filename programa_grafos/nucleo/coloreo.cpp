@@ -0,0 +1,194 @@
+#include "coloreo.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <queue>
+#include <unordered_set>
+
+namespace {
+
+int grado(const VistaCSR &grafo, int v)
+{
+    return grafo.inicio[v + 1] - grafo.inicio[v];
+}
+
+// Menor color que no está marcado con la marca de v. usado tiene una entrada
+// por color y crece a medida que aparecen vértices de más grado; un vértice
+// de grado g nunca necesita un color mayor que g
+template <typename LeerColor>
+int menorColorLibre(const VistaCSR &grafo, int v, std::vector<int> &usado, LeerColor leerColor)
+{
+    const int g = grado(grafo, v);
+    if (static_cast<int>(usado.size()) <= g) {
+        usado.resize(g + 1, -1);
+    }
+    for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+        const int c = leerColor(grafo.vecinos[k]);
+        if (c >= 0 && c <= g) {
+            usado[c] = v;
+        }
+    }
+    int c = 0;
+    while (usado[c] == v) {
+        ++c;
+    }
+    return c;
+}
+
+int cantidadColores(const std::vector<int> &color)
+{
+    return color.empty() ? 0 : *std::max_element(color.begin(), color.end()) + 1;
+}
+
+// Vértice pendiente en DSatur; sale primero el de más saturación, luego el de
+// más grado y luego el de menor id
+struct Candidato {
+    int saturacion;
+    int grado;
+    int v;
+
+    bool operator<(const Candidato &otro) const
+    {
+        if (saturacion != otro.saturacion) {
+            return saturacion < otro.saturacion;
+        }
+        return grado != otro.grado ? grado < otro.grado : v > otro.v;
+    }
+};
+
+} // namespace
+
+int coloreoVoraz(const VistaCSR &grafo, std::vector<int> &color)
+{
+    const int n = grafo.n;
+    color.assign(n, -1);
+
+    // Orden por grado decreciente con un conteo, sin comparar: O(n + grado máximo)
+    int gradoMaximo = 0;
+    for (int v = 0; v < n; ++v) {
+        gradoMaximo = std::max(gradoMaximo, grado(grafo, v));
+    }
+    std::vector<int> primero(gradoMaximo + 2, 0);
+    for (int v = 0; v < n; ++v) {
+        ++primero[gradoMaximo - grado(grafo, v) + 1];
+    }
+    std::partial_sum(primero.begin(), primero.end(), primero.begin());
+    std::vector<int> orden(n);
+    for (int v = 0; v < n; ++v) {
+        orden[primero[gradoMaximo - grado(grafo, v)]++] = v;
+    }
+
+    std::vector<int> usado;
+    for (int v : orden) {
+        color[v] = menorColorLibre(grafo, v, usado, [&](int w) { return color[w]; });
+    }
+    return cantidadColores(color);
+}
+
+int coloreoDSatur(const VistaCSR &grafo, std::vector<int> &color)
+{
+    const int n = grafo.n;
+    color.assign(n, -1);
+    std::vector<int> saturacion(n, 0);
+    // Colores de vecinos ya contados en la saturación de cada vértice: los 64
+    // primeros en una máscara y los demás, que son raros, en pares (vértice, color)
+    std::vector<std::uint64_t> vistosBajos(n, 0);
+    std::unordered_set<std::uint64_t> vistosAltos;
+    auto contar = [&](int w, int c) {
+        if (c < 64) {
+            const std::uint64_t bit = std::uint64_t(1) << c;
+            const bool nuevo = !(vistosBajos[w] & bit);
+            vistosBajos[w] |= bit;
+            return nuevo;
+        }
+        return vistosAltos.insert(static_cast<std::uint64_t>(w) << 32 | static_cast<std::uint32_t>(c)).second;
+    };
+
+    // Montículo con entradas viejas: cuando sube la saturación se agrega otra
+    // entrada y las anteriores se descartan al salir
+    std::priority_queue<Candidato> candidatos;
+    for (int v = 0; v < n; ++v) {
+        candidatos.push({0, grado(grafo, v), v});
+    }
+    std::vector<int> usado;
+    while (!candidatos.empty()) {
+        const Candidato candidato = candidatos.top();
+        candidatos.pop();
+        const int v = candidato.v;
+        if (color[v] >= 0 || candidato.saturacion != saturacion[v]) {
+            continue;
+        }
+        const int c = menorColorLibre(grafo, v, usado, [&](int w) { return color[w]; });
+        color[v] = c;
+        for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+            const int w = grafo.vecinos[k];
+            if (color[w] < 0 && contar(w, c)) {
+                candidatos.push({++saturacion[w], grado(grafo, w), w});
+            }
+        }
+    }
+    return cantidadColores(color);
+}
+
+int coloreoParalelo(const VistaCSR &grafo, PoolHilos &hilos, std::vector<int> &color)
+{
+    const int n = grafo.n;
+    // Atómicos con orden relajado: un hilo puede leer el color de un vecino que
+    // otro está cambiando, y esa carrera es justo la que se corrige después
+    std::vector<std::atomic<int>> actual(n);
+    hilos.paraCada(n, [&](int inicio, int fin) {
+        for (int v = inicio; v < fin; ++v) {
+            actual[v].store(-1, std::memory_order_relaxed);
+        }
+    });
+    auto leerColor = [&](int w) { return actual[w].load(std::memory_order_relaxed); };
+
+    std::vector<int> pendientes(n);
+    std::iota(pendientes.begin(), pendientes.end(), 0);
+    std::vector<char> conflicto;
+    while (!pendientes.empty()) {
+        const int cantidad = static_cast<int>(pendientes.size());
+
+        // Cada pendiente toma el menor color que no ve en sus vecinos
+        hilos.paraCada(cantidad, [&](int inicio, int fin) {
+            std::vector<int> usado; // Uno por bloque, no por vértice
+            for (int i = inicio; i < fin; ++i) {
+                const int v = pendientes[i];
+                actual[v].store(menorColorLibre(grafo, v, usado, leerColor), std::memory_order_relaxed);
+            }
+        });
+
+        // Los colores ya no cambian: si dos vecinos coinciden, el de mayor id
+        // se vuelve a colorear. Con un vértice que ya no está pendiente no puede
+        // haber conflicto, porque su color no cambió mientras el otro elegía
+        conflicto.assign(cantidad, 0);
+        hilos.paraCada(cantidad, [&](int inicio, int fin) {
+            for (int i = inicio; i < fin; ++i) {
+                const int v = pendientes[i];
+                const int c = leerColor(v);
+                for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+                    const int w = grafo.vecinos[k];
+                    if (w < v && leerColor(w) == c) {
+                        conflicto[i] = 1;
+                        break;
+                    }
+                }
+            }
+        });
+        int quedan = 0;
+        for (int i = 0; i < cantidad; ++i) {
+            if (conflicto[i]) {
+                pendientes[quedan++] = pendientes[i];
+            }
+        }
+        pendientes.resize(quedan);
+    }
+
+    color.resize(n);
+    for (int v = 0; v < n; ++v) {
+        color[v] = leerColor(v);
+    }
+    return cantidadColores(color);
+}
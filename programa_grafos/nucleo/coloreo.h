@@ -0,0 +1,29 @@
+#ifndef COLOREO_H
+#define COLOREO_H
+
+#include <vector>
+
+#include "grafo.h"
+#include "poolhilos.h"
+
+// Coloreo de vértices: dos vértices vecinos nunca tienen el mismo color. Cada
+// función deja en color el de cada vértice (0, 1, ...) y devuelve la cantidad
+// de colores usados. Ninguna garantiza el mínimo, que es un problema NP-difícil
+
+// Recorre los vértices de mayor a menor grado (Welsh–Powell) y a cada uno le
+// da el menor color que no tenga un vecino. O(n + m)
+int coloreoVoraz(const VistaCSR &grafo, std::vector<int> &color);
+
+// DSatur: colorea siempre el vértice con más colores distintos entre sus
+// vecinos (desempatando por grado), que suele necesitar menos colores que el
+// voraz. O((n + m) log n)
+int coloreoDSatur(const VistaCSR &grafo, std::vector<int> &color);
+
+// Coloreo especulativo en paralelo (Gebremedhin–Manne): todos los vértices
+// pendientes se colorean a la vez sin sincronizarse y después se buscan los
+// vecinos que quedaron con el mismo color; el de mayor id vuelve a quedar
+// pendiente. Cada ronda resuelve al menos un conflicto, y en la práctica casi
+// todos se resuelven en las primeras
+int coloreoParalelo(const VistaCSR &grafo, PoolHilos &hilos, std::vector<int> &color);
+
+#endif // COLOREO_H
@@ -0,0 +1,119 @@
+#include "conectividad.h"
+
+#include <utility>
+
+#include "algoritmos.h"
+
+void Conectividad::limpiar()
+{
+    padres.clear();
+    tamanos.clear();
+    registro.clear();
+    pasos.clear();
+    descartados = 0;
+    componentes = 0;
+}
+
+void Conectividad::reconstruir(const Grafo &grafo)
+{
+    limpiar();
+    std::vector<int> etiqueta;
+    componentes = componentesConexas(grafo.csr().vista(), etiqueta);
+
+    // Cada componente queda como una estrella colgada de su primer vértice: altura 1
+    std::vector<int> representante(componentes, -1);
+    padres.resize(etiqueta.size());
+    tamanos.assign(etiqueta.size(), 0);
+    for (size_t v = 0; v < etiqueta.size(); ++v) {
+        int &r = representante[etiqueta[v]];
+        if (r < 0) {
+            r = static_cast<int>(v);
+        }
+        padres[v] = r;
+        ++tamanos[r];
+    }
+}
+
+void Conectividad::abrirPaso()
+{
+    pasos.push_back(descartados + registro.size());
+}
+
+void Conectividad::deshacerPaso()
+{
+    if (pasos.empty()) {
+        return;
+    }
+    const size_t marca = pasos.back() - descartados;
+    pasos.pop_back();
+    while (registro.size() > marca) {
+        const int hecho = registro.back();
+        registro.pop_back();
+        if (hecho < 0) {
+            // El vértice agregado es siempre el último, y al quitarlo desaparece su componente
+            padres.pop_back();
+            tamanos.pop_back();
+            --componentes;
+        } else {
+            // hecho era una raíz: se descuelga y su antigua raíz pierde sus vértices
+            tamanos[padres[hecho]] -= tamanos[hecho];
+            padres[hecho] = hecho;
+            ++componentes;
+        }
+    }
+}
+
+void Conectividad::descartarPasos(int cantidad)
+{
+    // Lo registrado antes del primer paso que queda ya no se va a revertir
+    const size_t quedan = pasos.size() > static_cast<size_t>(cantidad) ? pasos.size() - cantidad : 0;
+    const size_t inicio = quedan > 0 ? pasos[pasos.size() - quedan] : descartados + registro.size();
+    pasos.erase(pasos.begin(), pasos.end() - quedan);
+    registro.erase(registro.begin(), registro.begin() + (inicio - descartados));
+    descartados = inicio;
+}
+
+void Conectividad::agregarVertice()
+{
+    padres.push_back(static_cast<int>(padres.size()));
+    tamanos.push_back(1);
+    ++componentes;
+    if (!pasos.empty()) {
+        registro.push_back(-1);
+    }
+}
+
+void Conectividad::unir(int a, int b)
+{
+    int ra = raiz(a), rb = raiz(b);
+    if (ra == rb) {
+        return; // Ya estaban en la misma componente: no hay nada que revertir
+    }
+    if (tamanos[ra] < tamanos[rb]) {
+        std::swap(ra, rb); // El árbol chico cuelga del grande, así la altura es O(log n)
+    }
+    padres[rb] = ra;
+    tamanos[ra] += tamanos[rb];
+    --componentes;
+    if (!pasos.empty()) {
+        registro.push_back(rb);
+    }
+}
+
+void Conectividad::unirLote(const Grafo &grafo, const Grafo::LoteAristas &lote)
+{
+    for (size_t i = 0; i < lote.vertices.size(); ++i) {
+        const PoolAdyacencia::Lista lista = grafo.aristasDe(lote.vertices[i]);
+        for (size_t k = lista.size() - lote.agregadas[i]; k < lista.size(); ++k) {
+            unir(lote.vertices[i], lista[k]);
+        }
+    }
+}
+
+int Conectividad::raiz(int v) const
+{
+    while (padres[v] != v) {
+        v = padres[v];
+    }
+    return v;
+}
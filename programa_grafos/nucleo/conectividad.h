@@ -0,0 +1,48 @@
+#ifndef CONECTIVIDAD_H
+#define CONECTIVIDAD_H
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include "grafo.h"
+
+// Clase que mantiene las componentes conexas mientras se edita el grafo, sin
+// recorrerlo de nuevo. Es un union-find con unión por tamaño y sin compresión
+// de caminos: las consultas cuestan O(log n) y cada unión se puede revertir
+// en O(1). Cada acción del historial abre un paso, y deshacer la acción
+// revierte su paso completo; como el historial también deshace en orden
+// inverso, los pasos siempre se revierten del más nuevo al más viejo. Cuando
+// el historial descarta sus acciones más viejas por el límite de memoria se
+// descartan otros tantos pasos, así el registro no crece sin fin
+class Conectividad {
+public:
+    void limpiar();
+    void reconstruir(const Grafo &grafo); // Desde cero; lo anterior ya no se puede revertir
+
+    void abrirPaso(); // Marca el comienzo de una acción que se podrá revertir
+    void deshacerPaso(); // Revierte todo lo hecho desde el último abrirPaso
+    void descartarPasos(int cantidad); // Los más viejos ya no se revertirán: se olvida lo que registraron
+
+    void agregarVertice(); // El vértice nuevo queda solo en su componente
+    void unir(int a, int b); // Se conectaron a y b
+    void unirLote(const Grafo &grafo, const Grafo::LoteAristas &lote); // Aristas del lote, ya agregadas al grafo
+
+    bool conectados(int a, int b) const { return raiz(a) == raiz(b); }
+    int cantidadComponentes() const { return componentes; }
+    int cantidadVertices() const { return static_cast<int>(padres.size()); }
+
+private:
+    int raiz(int v) const;
+
+    std::vector<int> padres; // Cada raíz es su propio padre
+    std::vector<int> tamanos; // Cantidad de vértices bajo cada raíz
+    // Lo hecho desde el primer paso: -1 si se agregó un vértice, o la raíz
+    // que se colgó de otra en una unión. Antes del primer paso no se registra
+    std::deque<int> registro;
+    std::deque<size_t> pasos; // Posición en el registro al abrir cada paso, contando lo descartado
+    size_t descartados = 0; // Entradas quitadas del principio del registro
+    int componentes = 0;
+};
+
+#endif // CONECTIVIDAD_H
@@ -0,0 +1,124 @@
+#include "conjuntoaristas.h"
+
+#include <algorithm>
+
+bool ConjuntoAristas::insertar(int a, int b)
+{
+    // Se mantiene la tabla a lo sumo llena hasta la mitad para que las cadenas sean cortas
+    if (2 * (ocupadas + 1) > casillas.size()) {
+        crecer(2 * (ocupadas + 1));
+    }
+
+    const std::uint64_t k = clave(a, b);
+    const size_t mascara = casillas.size() - 1;
+    for (size_t i = posicion(k);; i = (i + 1) & mascara) {
+        if (casillas[i] == k) {
+            return false;
+        }
+        if (casillas[i] == vacia) {
+            casillas[i] = k;
+            ++ocupadas;
+            return true;
+        }
+    }
+}
+
+bool ConjuntoAristas::quitar(int a, int b)
+{
+    if (ocupadas == 0) {
+        return false;
+    }
+
+    const std::uint64_t k = clave(a, b);
+    const size_t mascara = casillas.size() - 1;
+    size_t i = posicion(k);
+    while (casillas[i] != k) {
+        if (casillas[i] == vacia) {
+            return false;
+        }
+        i = (i + 1) & mascara;
+    }
+
+    // Borrado con corrimiento hacia atrás: se rellenan los huecos sin dejar marcas de borrado
+    size_t hueco = i;
+    for (size_t j = (hueco + 1) & mascara; casillas[j] != vacia; j = (j + 1) & mascara) {
+        const size_t inicio = posicion(casillas[j]);
+        // La entrada de j puede pasar al hueco si su casilla inicial no está entre el hueco y j
+        const bool entreHuecoYJ = hueco <= j ? (hueco < inicio && inicio <= j) : (hueco < inicio || inicio <= j);
+        if (!entreHuecoYJ) {
+            casillas[hueco] = casillas[j];
+            hueco = j;
+        }
+    }
+    casillas[hueco] = vacia;
+    --ocupadas;
+    return true;
+}
+
+bool ConjuntoAristas::contiene(int a, int b) const
+{
+    if (ocupadas == 0) {
+        return false;
+    }
+
+    const std::uint64_t k = clave(a, b);
+    const size_t mascara = casillas.size() - 1;
+    for (size_t i = posicion(k); casillas[i] != vacia; i = (i + 1) & mascara) {
+        if (casillas[i] == k) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ConjuntoAristas::reservar(size_t cantidad)
+{
+    if (2 * cantidad > casillas.size()) {
+        crecer(2 * cantidad);
+    }
+}
+
+void ConjuntoAristas::limpiar()
+{
+    std::vector<std::uint64_t>().swap(casillas); // Liberar la tabla es O(1): sus casillas no tienen destructor
+    ocupadas = 0;
+    desplazamiento = 64;
+}
+
+std::uint64_t ConjuntoAristas::clave(int a, int b)
+{
+    const std::uint32_t menor = static_cast<std::uint32_t>(std::min(a, b));
+    const std::uint32_t mayor = static_cast<std::uint32_t>(std::max(a, b));
+    return (static_cast<std::uint64_t>(menor) << 32) | mayor;
+}
+
+size_t ConjuntoAristas::posicion(std::uint64_t k) const
+{
+    return static_cast<size_t>((k * 0x9E3779B97F4A7C15ull) >> desplazamiento);
+}
+
+void ConjuntoAristas::crecer(size_t capacidadMinima)
+{
+    size_t capacidad = 16;
+    int bits = 4;
+    while (capacidad < capacidadMinima) {
+        capacidad *= 2;
+        ++bits;
+    }
+
+    std::vector<std::uint64_t> anteriores(capacidad, vacia);
+    anteriores.swap(casillas);
+    desplazamiento = 64 - bits;
+
+    const size_t mascara = capacidad - 1;
+    for (std::uint64_t k : anteriores) {
+        if (k == vacia) {
+            continue;
+        }
+        size_t i = posicion(k);
+        while (casillas[i] != vacia) {
+            i = (i + 1) & mascara;
+        }
+        casillas[i] = k;
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef CONJUNTOARISTAS_H
+#define CONJUNTOARISTAS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Conjunto de aristas no dirigidas con direccionamiento abierto sobre un
+// arreglo plano: insertar, buscar y quitar cuestan O(1) amortizado y no se
+// reserva memoria por cada arista
+class ConjuntoAristas {
+public:
+    bool insertar(int a, int b); // Devuelve false si la arista ya estaba
+    bool quitar(int a, int b); // Devuelve false si la arista no estaba
+    bool contiene(int a, int b) const;
+    void reservar(size_t cantidad); // Prepara espacio para esa cantidad de aristas sin rehacer la tabla
+    void limpiar();
+
+private:
+    static std::uint64_t clave(int a, int b); // Clave independiente del orden de los extremos
+    size_t posicion(std::uint64_t k) const; // Casilla inicial de una clave
+    void crecer(size_t capacidadMinima); // Rehace la tabla con al menos esa capacidad
+
+    static constexpr std::uint64_t vacia = ~std::uint64_t(0); // Marca de casilla libre
+
+    std::vector<std::uint64_t> casillas; // Tabla con sondeo lineal; su tamaño es potencia de dos
+    size_t ocupadas = 0; // Cantidad de aristas guardadas
+    int desplazamiento = 64; // 64 - log2(tamaño de la tabla), para el hash multiplicativo
+};
+
+#endif // CONJUNTOARISTAS_H
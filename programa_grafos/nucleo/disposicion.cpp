@@ -0,0 +1,234 @@
+#include "disposicion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+#include "vectorial.h"
+
+namespace {
+
+const int verticesPorHoja = 16; // Las celdas con menos vértices no se dividen
+const int profundidadMaxima = 16; // Un nivel por cada par de bits del código Z
+
+// Intercala los bits de dos coordenadas de 16 bits (curva Z)
+std::uint32_t codigoMorton(std::uint32_t x, std::uint32_t y)
+{
+    auto separar = [](std::uint32_t v) {
+        v = (v | (v << 8)) & 0x00ff00ffu;
+        v = (v | (v << 4)) & 0x0f0f0f0fu;
+        v = (v | (v << 2)) & 0x33333333u;
+        v = (v | (v << 1)) & 0x55555555u;
+        return v;
+    };
+    return separar(x) | (separar(y) << 1);
+}
+
+} // namespace
+
+DisposicionFuerzas::DisposicionFuerzas(PoolHilos &hilos) : hilos(hilos)
+{
+}
+
+void DisposicionFuerzas::iniciar(const Grafo &grafo)
+{
+    xs = grafo.posicionesX();
+    ys = grafo.posicionesY();
+    // Un desplazamiento invisible separa los vértices que estén exactamente en el mismo lugar
+    for (size_t v = 0; v < xs.size(); ++v) {
+        xs[v] += 1e-3 * std::cos(v * 2.399963229728653);
+        ys[v] += 1e-3 * std::sin(v * 2.399963229728653);
+    }
+    fx.assign(xs.size(), 0);
+    fy.assign(xs.size(), 0);
+    unos.assign(xs.size(), 1);
+    // Al principio un vértice puede cruzar una fracción del dibujo completo
+    temperatura = xs.empty() ? 0 : parametros.distancia * std::max(1.0, std::sqrt(static_cast<double>(xs.size())) / 4);
+}
+
+void DisposicionFuerzas::paso(const VistaCSR &csr)
+{
+    const int n = cantidadVertices();
+    if (n == 0 || csr.n != n) {
+        temperatura = 0;
+        return;
+    }
+    ordenarVertices();
+    arbol.clear();
+    Celda raiz;
+    raiz.inicio = 0;
+    raiz.fin = n;
+    raiz.lado = ladoRaiz;
+    arbol.push_back(raiz);
+    construirCelda(0, 0);
+    hilos.paraCada(n, [this, &csr](int inicio, int fin) { calcularFuerzas(csr, inicio, fin); }, 256);
+
+    // Cada vértice se mueve en la dirección de su fuerza, como mucho la temperatura actual
+    const double limite = temperatura;
+    hilos.paraCada(n, [this, limite](int inicio, int fin) {
+        for (int v = inicio; v < fin; ++v) {
+            const double largo = std::sqrt(fx[v] * fx[v] + fy[v] * fy[v]);
+            if (largo > 0) {
+                const double escala = std::min(largo, limite) / largo;
+                xs[v] += fx[v] * escala;
+                ys[v] += fy[v] * escala;
+            }
+        }
+    });
+    temperatura *= parametros.enfriamiento;
+}
+
+void DisposicionFuerzas::ordenarVertices()
+{
+    double xMin = xs[0], xMax = xs[0], yMin = ys[0], yMax = ys[0];
+    double sumaX = 0, sumaY = 0;
+    for (size_t v = 0; v < xs.size(); ++v) {
+        xMin = std::min(xMin, xs[v]);
+        xMax = std::max(xMax, xs[v]);
+        yMin = std::min(yMin, ys[v]);
+        yMax = std::max(yMax, ys[v]);
+        sumaX += xs[v];
+        sumaY += ys[v];
+    }
+    centroX = sumaX / xs.size();
+    centroY = sumaY / xs.size();
+    ladoRaiz = std::max(xMax - xMin, yMax - yMin) + 1;
+
+    // Los vértices cercanos en el plano quedan juntos en el orden, en el árbol
+    // y en los bloques de cada hilo
+    const double escala = 65535 / ladoRaiz;
+    std::vector<std::pair<std::uint32_t, int>> pares(xs.size());
+    for (size_t v = 0; v < xs.size(); ++v) {
+        pares[v] = {codigoMorton(static_cast<std::uint32_t>((xs[v] - xMin) * escala),
+                                 static_cast<std::uint32_t>((ys[v] - yMin) * escala)),
+                    static_cast<int>(v)};
+    }
+    std::sort(pares.begin(), pares.end());
+    orden.resize(xs.size());
+    codigos.resize(xs.size());
+    ordenX.resize(xs.size());
+    ordenY.resize(xs.size());
+    for (size_t i = 0; i < pares.size(); ++i) {
+        codigos[i] = pares[i].first;
+        orden[i] = pares[i].second;
+        ordenX[i] = xs[orden[i]];
+        ordenY[i] = ys[orden[i]];
+    }
+}
+
+void DisposicionFuerzas::construirCelda(int celda, int nivel)
+{
+    const int inicio = arbol[celda].inicio, fin = arbol[celda].fin;
+    if (fin - inicio <= verticesPorHoja || nivel == profundidadMaxima) {
+        double sumaX = 0, sumaY = 0;
+        for (int i = inicio; i < fin; ++i) {
+            sumaX += ordenX[i];
+            sumaY += ordenY[i];
+        }
+        arbol[celda].centroX = sumaX / (fin - inicio);
+        arbol[celda].centroY = sumaY / (fin - inicio);
+        return;
+    }
+
+    // Los códigos del tramo comparten los bits de los niveles anteriores; el
+    // par siguiente dice en qué cuadrante cae cada vértice, en orden
+    const int desplazamiento = 2 * (profundidadMaxima - 1 - nivel);
+    const int primero = static_cast<int>(arbol.size());
+    int a = inicio;
+    for (std::uint32_t q = 0; q < 4 && a < fin; ++q) {
+        const int b = static_cast<int>(
+            std::partition_point(codigos.begin() + a, codigos.begin() + fin,
+                                 [&](std::uint32_t codigo) { return ((codigo >> desplazamiento) & 3u) <= q; })
+            - codigos.begin());
+        if (b > a) {
+            Celda hijo;
+            hijo.inicio = a;
+            hijo.fin = b;
+            hijo.lado = arbol[celda].lado / 2;
+            arbol.push_back(hijo);
+        }
+        a = b;
+    }
+    const int cantidad = static_cast<int>(arbol.size()) - primero;
+    arbol[celda].hijos = primero;
+    arbol[celda].cantidadHijos = cantidad;
+
+    double sumaX = 0, sumaY = 0;
+    for (int h = primero; h < primero + cantidad; ++h) {
+        construirCelda(h, nivel + 1);
+        sumaX += arbol[h].centroX * (arbol[h].fin - arbol[h].inicio);
+        sumaY += arbol[h].centroY * (arbol[h].fin - arbol[h].inicio);
+    }
+    arbol[celda].centroX = sumaX / (fin - inicio);
+    arbol[celda].centroY = sumaY / (fin - inicio);
+}
+
+void DisposicionFuerzas::calcularFuerzas(const VistaCSR &csr, int inicio, int fin)
+{
+    const double k = parametros.distancia;
+    const double k2 = k * k;
+    const double theta2 = parametros.theta * parametros.theta;
+    int pila[3 * profundidadMaxima + 8]; // Cada nivel deja a lo sumo tres hermanos pendientes
+
+    // Se recorre en el orden de la curva Z: vértices seguidos visitan casi las mismas celdas
+    for (int i = inicio; i < fin; ++i) {
+        const int v = orden[i];
+        const double x = xs[v], y = ys[v];
+        double fuerzaX = 0, fuerzaY = 0;
+
+        // Repulsión: una celda lejana actúa como un solo vértice en su centro
+        // de masa; las hojas cercanas se suman vértice por vértice
+        int alto = 0;
+        pila[alto++] = 0;
+        while (alto > 0) {
+            const Celda &celda = arbol[pila[--alto]];
+            const bool contiene = i >= celda.inicio && i < celda.fin;
+            const double dx = x - celda.centroX, dy = y - celda.centroY;
+            const double d2 = dx * dx + dy * dy;
+            if (!contiene && celda.lado * celda.lado < theta2 * d2) {
+                const double f = k2 * (celda.fin - celda.inicio) / d2;
+                fuerzaX += dx * f;
+                fuerzaY += dy * f;
+                continue;
+            }
+            if (celda.hijos < 0) {
+                if (contiene) {
+                    // v no se repele a sí mismo: se suman los tramos antes y después de él
+                    acumularRepulsion(ordenX.data() + celda.inicio, ordenY.data() + celda.inicio, unos.data(),
+                                      i - celda.inicio, x, y, k2, fuerzaX, fuerzaY);
+                    acumularRepulsion(ordenX.data() + i + 1, ordenY.data() + i + 1, unos.data(), celda.fin - i - 1,
+                                      x, y, k2, fuerzaX, fuerzaY);
+                } else {
+                    acumularRepulsion(ordenX.data() + celda.inicio, ordenY.data() + celda.inicio, unos.data(),
+                                      celda.fin - celda.inicio, x, y, k2, fuerzaX, fuerzaY);
+                }
+                continue;
+            }
+            for (int h = 0; h < celda.cantidadHijos; ++h) {
+                pila[alto++] = celda.hijos + h;
+            }
+        }
+
+        // Atracción de cada arista, proporcional al cuadrado de su largo
+        for (int j = csr.inicio[v]; j < csr.inicio[v + 1]; ++j) {
+            const int w = csr.vecinos[j];
+            const double dx = xs[w] - x, dy = ys[w] - y;
+            const double d = std::sqrt(dx * dx + dy * dy);
+            fuerzaX += dx * d / k;
+            fuerzaY += dy * d / k;
+        }
+
+        // Gravedad hacia el centro, más fuerte para los vértices de mayor grado
+        const double dx = centroX - x, dy = centroY - y;
+        const double d = std::sqrt(dx * dx + dy * dy);
+        if (d > 0) {
+            const double g = parametros.gravedad * k * (csr.grado(v) + 1) / d;
+            fuerzaX += dx * g;
+            fuerzaY += dy * g;
+        }
+
+        fx[v] = fuerzaX;
+        fy[v] = fuerzaY;
+    }
+}
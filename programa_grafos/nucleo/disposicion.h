@@ -0,0 +1,69 @@
+#ifndef DISPOSICION_H
+#define DISPOSICION_H
+
+#include <cstdint>
+#include <vector>
+
+#include "grafo.h"
+#include "poolhilos.h"
+
+// Clase que distribuye los vértices con un modelo de fuerzas al estilo de
+// Fruchterman–Reingold: las aristas atraen a sus extremos y todos los vértices
+// se repelen entre sí. La repulsión se aproxima con un árbol cuaternario de
+// Barnes–Hut (O(n log n) por paso) y las fuerzas se calculan en paralelo.
+// Cada paso mueve los vértices un poco; la temperatura limita ese movimiento
+// y baja en cada paso hasta que la distribución se asienta
+class DisposicionFuerzas {
+public:
+    explicit DisposicionFuerzas(PoolHilos &hilos);
+
+    // Toma las posiciones actuales del grafo y fija la temperatura inicial
+    void iniciar(const Grafo &grafo);
+
+    // Avanza una iteración sobre la adyacencia dada (la del grafo de iniciar)
+    void paso(const VistaCSR &csr);
+
+    bool asentada() const { return temperatura < parametros.temperaturaMinima; }
+    int cantidadVertices() const { return static_cast<int>(xs.size()); }
+    const std::vector<double> &posicionesX() const { return xs; }
+    const std::vector<double> &posicionesY() const { return ys; }
+
+private:
+    struct Parametros {
+        double distancia = 40; // Largo ideal de una arista, en píxeles
+        double theta = 1.2; // Precisión de Barnes–Hut: menor es más exacto y más lento
+        double gravedad = 0.05; // Atracción hacia el centro para que las componentes no se alejen
+        double enfriamiento = 0.95; // Factor con que baja la temperatura en cada paso
+        double temperaturaMinima = 0.5; // Por debajo de este desplazamiento se considera asentada
+    };
+
+    // Celda del árbol. Los vértices se ordenan por curva Z, así que cada celda
+    // cubre un tramo contiguo de ese orden; las hojas guardan varios vértices
+    // y su repulsión se suma directamente con los núcleos vectoriales
+    struct Celda {
+        double centroX, centroY; // Centro de masa
+        double lado; // Lado del cuadrado que cubre
+        int inicio, fin; // Tramo [inicio, fin) del orden
+        int hijos = -1; // Índice del primer hijo, o -1 si es hoja
+        int cantidadHijos = 0; // Solo se crean los hijos no vacíos, consecutivos
+    };
+
+    void ordenarVertices();
+    void construirCelda(int celda, int nivel);
+    void calcularFuerzas(const VistaCSR &csr, int inicio, int fin);
+
+    PoolHilos &hilos;
+    Parametros parametros;
+    std::vector<double> xs, ys; // Posiciones que se van moviendo
+    std::vector<double> fx, fy; // Fuerza acumulada en el paso actual
+    std::vector<Celda> arbol; // Se reutiliza entre pasos
+    std::vector<int> orden; // Vértices ordenados por curva Z
+    std::vector<std::uint32_t> codigos; // Código Z de cada posición del orden
+    std::vector<double> ordenX, ordenY; // Posiciones en el orden de la curva Z
+    std::vector<double> unos; // Masa de cada vértice, para los núcleos vectoriales
+    double centroX = 0, centroY = 0; // Centro de masa de todos los vértices
+    double ladoRaiz = 1; // Lado del cuadrado que cubre todos los vértices
+    double temperatura = 0;
+};
+
+#endif // DISPOSICION_H
@@ -0,0 +1,286 @@
+#include "formatobinario.h"
+
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const char magiaEsperada[8] = {'G', 'R', 'A', 'F', 'O', 'B', 'I', 'N'};
+const std::uint32_t versionActual = 1;
+
+// Comprueba que la CSR no tenga lazos ni aristas repetidas y que cada arista
+// aparezca en sus dos extremos, como la escribe guardarGrafoBinario. Los
+// algoritmos y copiarEn lo dan por hecho. O(n + m): se arma la traspuesta y
+// se compara cada lista con la suya marcando los vecinos
+bool adyacenciaSimetrica(const VistaCSR &csr, std::string &error)
+{
+    const int n = csr.n;
+    std::vector<int> inicioTraspuesta(n + 1, 0);
+    for (int k = 0; k < csr.inicio[n]; ++k) {
+        ++inicioTraspuesta[csr.vecinos[k] + 1];
+    }
+    for (int v = 0; v < n; ++v) {
+        inicioTraspuesta[v + 1] += inicioTraspuesta[v];
+    }
+    std::vector<int> traspuesta(csr.inicio[n]);
+    {
+        std::vector<int> siguiente(inicioTraspuesta.begin(), inicioTraspuesta.end() - 1);
+        for (int v = 0; v < n; ++v) {
+            for (int k = csr.inicio[v]; k < csr.inicio[v + 1]; ++k) {
+                traspuesta[siguiente[csr.vecinos[k]]++] = v;
+            }
+        }
+    }
+
+    std::vector<int> marca(n, -1); // marca[w] == v si w está en la lista de v
+    for (int v = 0; v < n; ++v) {
+        if (csr.inicio[v + 1] - csr.inicio[v] != inicioTraspuesta[v + 1] - inicioTraspuesta[v]) {
+            error = "la adyacencia no es simétrica";
+            return false;
+        }
+        for (int k = csr.inicio[v]; k < csr.inicio[v + 1]; ++k) {
+            const int w = csr.vecinos[k];
+            if (w == v) {
+                error = "el vértice " + std::to_string(v) + " tiene un lazo";
+                return false;
+            }
+            if (marca[w] == v) {
+                error = "la arista " + std::to_string(v) + "-" + std::to_string(w) + " está repetida";
+                return false;
+            }
+            marca[w] = v;
+        }
+        // Con los mismos tamaños y sin repetidas, basta que cada u que tiene a v esté en la lista de v
+        for (int k = inicioTraspuesta[v]; k < inicioTraspuesta[v + 1]; ++k) {
+            if (marca[traspuesta[k]] != v) {
+                error = "la adyacencia no es simétrica";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+ArchivoGrafoBinario::~ArchivoGrafoBinario()
+{
+    cerrar();
+}
+
+bool ArchivoGrafoBinario::abrir(const std::string &ruta, std::string &error)
+{
+    cerrar();
+
+#ifdef _WIN32
+    HANDLE manejador = CreateFileA(ruta.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                   FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (manejador == INVALID_HANDLE_VALUE) {
+        error = "no se pudo abrir el archivo";
+        return false;
+    }
+    archivo = manejador;
+    LARGE_INTEGER tamanoArchivo;
+    if (!GetFileSizeEx(manejador, &tamanoArchivo) || tamanoArchivo.QuadPart < static_cast<LONGLONG>(sizeof(CabeceraGrafoBinario))) {
+        error = "el archivo es demasiado corto";
+        cerrar();
+        return false;
+    }
+    tamano = static_cast<size_t>(tamanoArchivo.QuadPart);
+    mapeo = CreateFileMappingA(manejador, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    datos = mapeo ? MapViewOfFile(mapeo, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!datos) {
+        error = "no se pudo mapear el archivo";
+        cerrar();
+        return false;
+    }
+#else
+    const int descriptor = ::open(ruta.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        error = "no se pudo abrir el archivo";
+        return false;
+    }
+    struct stat estado;
+    if (::fstat(descriptor, &estado) != 0 || estado.st_size < static_cast<off_t>(sizeof(CabeceraGrafoBinario))) {
+        ::close(descriptor);
+        error = "el archivo es demasiado corto";
+        return false;
+    }
+    tamano = static_cast<size_t>(estado.st_size);
+    void *mapa = ::mmap(nullptr, tamano, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor); // El mapeo sigue siendo válido sin el descriptor
+    if (mapa == MAP_FAILED) {
+        tamano = 0;
+        error = "no se pudo mapear el archivo";
+        return false;
+    }
+    datos = mapa;
+#endif
+
+    // Validación de la cabecera y de los tamaños antes de confiar en los datos
+    CabeceraGrafoBinario cabecera;
+    std::memcpy(&cabecera, datos, sizeof(cabecera));
+    if (std::memcmp(cabecera.magia, magiaEsperada, sizeof(magiaEsperada)) != 0) {
+        error = "no es un archivo .grafo";
+        cerrar();
+        return false;
+    }
+    if (cabecera.version != versionActual) {
+        error = "versión de archivo no soportada";
+        cerrar();
+        return false;
+    }
+    if (cabecera.vertices >= static_cast<std::uint64_t>(INT_MAX) || cabecera.entradas > static_cast<std::uint64_t>(INT_MAX)) {
+        error = "el grafo es demasiado grande";
+        cerrar();
+        return false;
+    }
+    const std::uint64_t n = cabecera.vertices;
+    const std::uint64_t esperado = sizeof(CabeceraGrafoBinario) + 2 * n * sizeof(double)
+                                   + (n + 1) * sizeof(std::int32_t) + cabecera.entradas * sizeof(std::int32_t);
+    if (esperado != tamano) {
+        error = "el tamaño del archivo no coincide con su cabecera";
+        cerrar();
+        return false;
+    }
+
+    const char *bytes = static_cast<const char *>(datos);
+    xs = reinterpret_cast<const double *>(bytes + sizeof(CabeceraGrafoBinario));
+    ys = xs + n;
+    vista.n = static_cast<int>(n);
+    vista.inicio = reinterpret_cast<const int *>(ys + n);
+    vista.vecinos = vista.inicio + n + 1;
+
+    // Una posición infinita o NaN rompería el índice espacial y el dibujo
+    for (std::uint64_t v = 0; v < n; ++v) {
+        if (!std::isfinite(xs[v]) || !std::isfinite(ys[v])) {
+            error = "el vértice " + std::to_string(v) + " tiene una posición no finita";
+            cerrar();
+            return false;
+        }
+    }
+
+    // Se recorre la CSR una vez para que ningún algoritmo lea fuera del archivo
+    if (vista.inicio[0] != 0 || static_cast<std::uint64_t>(vista.inicio[n]) != cabecera.entradas) {
+        error = "la adyacencia está dañada";
+        cerrar();
+        return false;
+    }
+    for (int v = 0; v < vista.n; ++v) {
+        if (vista.inicio[v + 1] < vista.inicio[v]) {
+            error = "la adyacencia está dañada";
+            cerrar();
+            return false;
+        }
+    }
+    for (std::uint64_t k = 0; k < cabecera.entradas; ++k) {
+        if (vista.vecinos[k] < 0 || vista.vecinos[k] >= vista.n) {
+            error = "la adyacencia está dañada";
+            cerrar();
+            return false;
+        }
+    }
+    if (!adyacenciaSimetrica(vista, error)) {
+        cerrar();
+        return false;
+    }
+    return true;
+}
+
+void ArchivoGrafoBinario::cerrar()
+{
+#ifdef _WIN32
+    if (datos) {
+        UnmapViewOfFile(datos);
+    }
+    if (mapeo) {
+        CloseHandle(mapeo);
+    }
+    if (archivo) {
+        CloseHandle(archivo);
+    }
+    mapeo = nullptr;
+    archivo = nullptr;
+#else
+    if (datos) {
+        ::munmap(const_cast<void *>(datos), tamano);
+    }
+#endif
+    datos = nullptr;
+    tamano = 0;
+    xs = ys = nullptr;
+    vista = VistaCSR();
+}
+
+void ArchivoGrafoBinario::copiarEn(Grafo &grafo) const
+{
+    grafo.limpiar();
+    grafo.reservarVertices(vista.n);
+    grafo.reservarAristas(vista.inicio[vista.n] / 2);
+    for (int v = 0; v < vista.n; ++v) {
+        grafo.agregarVertice(xs[v], ys[v]);
+    }
+    // Cada arista aparece en sus dos extremos (abrir lo comprobó); se inserta solo desde el menor
+    for (int v = 0; v < vista.n; ++v) {
+        for (int k = vista.inicio[v]; k < vista.inicio[v + 1]; ++k) {
+            if (vista.vecinos[k] > v) {
+                grafo.conectar(v, vista.vecinos[k]);
+            }
+        }
+    }
+}
+
+bool ArchivoGrafoBinario::esBinario(const std::string &ruta)
+{
+    std::ifstream entrada(ruta, std::ios::binary);
+    char magia[sizeof(magiaEsperada)] = {};
+    return entrada.read(magia, sizeof(magia)) && std::memcmp(magia, magiaEsperada, sizeof(magia)) == 0;
+}
+
+bool guardarGrafoBinario(const std::string &ruta, const Grafo &grafo, std::string &error)
+{
+    std::ofstream salida(ruta, std::ios::binary | std::ios::trunc);
+    if (!salida) {
+        error = "no se pudo crear el archivo";
+        return false;
+    }
+
+    const Grafo::CSR &csr = grafo.csr();
+    CabeceraGrafoBinario cabecera;
+    std::memcpy(cabecera.magia, magiaEsperada, sizeof(magiaEsperada));
+    cabecera.version = versionActual;
+    cabecera.reservado = 0;
+    cabecera.vertices = static_cast<std::uint64_t>(grafo.cantidadVertices());
+    cabecera.entradas = static_cast<std::uint64_t>(csr.vecinos.size());
+
+    // Cada arreglo se escribe de una sola vez
+    auto escribir = [&salida](const void *bytes, size_t cantidad) {
+        salida.write(static_cast<const char *>(bytes), static_cast<std::streamsize>(cantidad));
+    };
+    escribir(&cabecera, sizeof(cabecera));
+    escribir(grafo.posicionesX().data(), grafo.posicionesX().size() * sizeof(double));
+    escribir(grafo.posicionesY().data(), grafo.posicionesY().size() * sizeof(double));
+    escribir(csr.inicio.data(), csr.inicio.size() * sizeof(std::int32_t));
+    escribir(csr.vecinos.data(), csr.vecinos.size() * sizeof(std::int32_t));
+    salida.close();
+    if (!salida) {
+        error = "no se pudo escribir el archivo";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+#ifndef FORMATOBINARIO_H
+#define FORMATOBINARIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "grafo.h"
+
+// Formato binario del programa (.grafo), en el orden de bytes de la máquina:
+//   cabecera (32 bytes): "GRAFOBIN", versión, reservado, n, cantidad de entradas
+//   double x[n], double y[n]
+//   int32 inicio[n + 1], int32 vecinos[entradas]   (CSR simétrica, sin lazos ni repetidas)
+// Está pensado para mapearse en memoria y usarse tal cual, sin interpretar texto
+struct CabeceraGrafoBinario {
+    char magia[8]; // "GRAFOBIN" sin terminador
+    std::uint32_t version;
+    std::uint32_t reservado;
+    std::uint64_t vertices;
+    std::uint64_t entradas; // Tamaño de vecinos: dos por cada arista
+};
+
+// Archivo .grafo mapeado en memoria de solo lectura. Las posiciones y la CSR
+// apuntan directamente al archivo, sin copiarlo
+class ArchivoGrafoBinario {
+public:
+    ArchivoGrafoBinario() = default;
+    ~ArchivoGrafoBinario();
+    ArchivoGrafoBinario(const ArchivoGrafoBinario &) = delete;
+    ArchivoGrafoBinario &operator=(const ArchivoGrafoBinario &) = delete;
+
+    // Mapea y valida el archivo, incluida la simetría de la adyacencia; si
+    // falla devuelve false y lo describe en error
+    bool abrir(const std::string &ruta, std::string &error);
+    void cerrar();
+
+    int cantidadVertices() const { return vista.n; }
+    const double *posicionesX() const { return xs; }
+    const double *posicionesY() const { return ys; }
+    const VistaCSR &csr() const { return vista; }
+
+    // Copia el contenido a un grafo editable, reservando todo de una vez
+    void copiarEn(Grafo &grafo) const;
+
+    // Indica si el archivo empieza con la marca del formato binario
+    static bool esBinario(const std::string &ruta);
+
+private:
+    const void *datos = nullptr; // Inicio del mapeo
+    size_t tamano = 0; // Bytes mapeados
+#ifdef _WIN32
+    void *archivo = nullptr; // HANDLE del archivo
+    void *mapeo = nullptr; // HANDLE del mapeo
+#endif
+    const double *xs = nullptr;
+    const double *ys = nullptr;
+    VistaCSR vista;
+};
+
+// Escribe el grafo en formato binario
+bool guardarGrafoBinario(const std::string &ruta, const Grafo &grafo, std::string &error);
+
+#endif // FORMATOBINARIO_H
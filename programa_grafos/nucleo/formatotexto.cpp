@@ -0,0 +1,94 @@
+#include "formatotexto.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+
+// Lee un número real finito desde cursor y lo avanza; devuelve false si no
+// hay número o si es inf o nan, que strtod acepta
+bool leerReal(const char *&cursor, double &valor)
+{
+    char *fin = nullptr;
+    errno = 0;
+    valor = std::strtod(cursor, &fin);
+    if (fin == cursor || errno == ERANGE || !std::isfinite(valor)) {
+        return false;
+    }
+    cursor = fin;
+    return true;
+}
+
+// Lee un entero no negativo desde cursor y lo avanza
+bool leerEntero(const char *&cursor, int &valor)
+{
+    char *fin = nullptr;
+    errno = 0;
+    const long leido = std::strtol(cursor, &fin, 10);
+    if (fin == cursor || errno == ERANGE || leido < 0 || leido > 0x7fffffff) {
+        return false;
+    }
+    valor = static_cast<int>(leido);
+    cursor = fin;
+    return true;
+}
+
+} // namespace
+
+bool cargarGrafoTexto(std::istream &entrada, Grafo &grafo, std::string &error)
+{
+    const int base = grafo.cantidadVertices(); // Los ids del archivo se suman a los ya existentes
+    std::string linea;
+    long numeroLinea = 0;
+    while (std::getline(entrada, linea)) {
+        ++numeroLinea;
+        const char *cursor = linea.c_str();
+        while (*cursor == ' ' || *cursor == '\t' || *cursor == '\r') {
+            ++cursor;
+        }
+        if (*cursor == '\0' || *cursor == '#') {
+            continue; // Línea vacía o comentario
+        }
+
+        const char tipo = *cursor++;
+        if (tipo == 'v') {
+            double x = 0, y = 0;
+            if (!leerReal(cursor, x) || !leerReal(cursor, y)) {
+                error = "línea " + std::to_string(numeroLinea) + ": se esperaba 'v x y' con coordenadas finitas";
+                return false;
+            }
+            grafo.agregarVertice(x, y);
+        } else if (tipo == 'e') {
+            int a = 0, b = 0;
+            if (!leerEntero(cursor, a) || !leerEntero(cursor, b)) {
+                error = "línea " + std::to_string(numeroLinea) + ": se esperaba 'e a b'";
+                return false;
+            }
+            if (base + a >= grafo.cantidadVertices() || base + b >= grafo.cantidadVertices()) {
+                error = "línea " + std::to_string(numeroLinea) + ": la arista usa un vértice no declarado";
+                return false;
+            }
+            grafo.conectar(base + a, base + b); // Las aristas repetidas se ignoran
+        } else {
+            error = "línea " + std::to_string(numeroLinea) + ": tipo de línea desconocido";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool guardarGrafoTexto(std::ostream &salida, const Grafo &grafo)
+{
+    salida.precision(17); // Suficiente para recuperar exactamente cada double
+    salida << "# " << grafo.cantidadVertices() << " vertices, " << grafo.cantidadAristas() << " aristas\n";
+    for (int v = 0; v < grafo.cantidadVertices(); ++v) {
+        salida << "v " << grafo.x(v) << ' ' << grafo.y(v) << '\n';
+    }
+    for (int v = 0; v < grafo.cantidadVertices(); ++v) {
+        for (int w : grafo.aristasDe(v)) {
+            salida << "e " << v << ' ' << w << '\n';
+        }
+    }
+    return static_cast<bool>(salida);
+}
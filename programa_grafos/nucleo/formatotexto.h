@@ -0,0 +1,22 @@
+#ifndef FORMATOTEXTO_H
+#define FORMATOTEXTO_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "grafo.h"
+
+// Formato de texto propio del programa (.graph), una línea por elemento:
+//   # comentario
+//   v x y    agrega un vértice; los ids se asignan 0, 1, 2... en orden
+//   e a b    conecta dos vértices ya declarados
+// La lectura es línea por línea, sin cargar el archivo completo en memoria
+
+// Agrega al grafo lo leído; si hay un error devuelve false y lo describe en error
+bool cargarGrafoTexto(std::istream &entrada, Grafo &grafo, std::string &error);
+
+// Escribe el grafo completo en el formato anterior
+bool guardarGrafoTexto(std::ostream &salida, const Grafo &grafo);
+
+#endif // FORMATOTEXTO_H
@@ -0,0 +1,200 @@
+#include "grafo.h"
+
+#include <algorithm>
+#include <utility>
+
+void Grafo::reservarVertices(int cantidad)
+{
+    xs.reserve(cantidad);
+    ys.reserve(cantidad);
+    grados.reserve(cantidad);
+    aristasSalientes.reservarListas(cantidad);
+}
+
+void Grafo::reservarAristas(int cantidad)
+{
+    conjunto.reservar(static_cast<size_t>(cantidad));
+}
+
+int Grafo::agregarVertice(double x, double y)
+{
+    xs.push_back(x);
+    ys.push_back(y);
+    aristasSalientes.crearLista(); // No reserva memoria hasta que el vértice reciba una arista
+    grados.push_back(0);
+    csrValida = false;
+    ++cambios;
+    return cantidadVertices() - 1;
+}
+
+void Grafo::eliminarUltimoVertice()
+{
+    if (xs.empty()) {
+        return;
+    }
+
+    const int v = cantidadVertices() - 1;
+    // Es el de mayor id, así que sus aristas están en las listas de otros vértices.
+    // Normalmente deshacer ya las quitó; si no, se buscan
+    for (int u = 0; u < v && grados[v] > 0; ++u) {
+        if (aristasSalientes.quitar(u, v)) {
+            conjunto.quitar(u, v);
+            --grados[u];
+            --grados[v];
+            --aristas;
+        }
+    }
+    aristasSalientes.eliminarUltimaLista(); // Su bloque queda libre para reutilizarse
+    grados.pop_back();
+    xs.pop_back();
+    ys.pop_back();
+    csrValida = false;
+    ++cambios;
+}
+
+bool Grafo::conectar(int a, int b)
+{
+    if (a == b || !conjunto.insertar(a, b)) {
+        return false; // Lazo o arista repetida
+    }
+    aristasSalientes.agregar(std::min(a, b), std::max(a, b)); // Una sola entrada por arista
+    ++grados[a];
+    ++grados[b];
+    ++aristas;
+    csrValida = false;
+    ++cambios;
+    return true;
+}
+
+void Grafo::limpiar()
+{
+    // Ningún arreglo guarda objetos con destructor, así que no se libera vértice por vértice
+    xs.clear();
+    ys.clear();
+    aristasSalientes.limpiar();
+    grados.clear();
+    conjunto.limpiar();
+    aristas = 0;
+    csrValida = false;
+    ++cambios;
+}
+
+Grafo::LoteAristas Grafo::conectarTodos(std::vector<int> vertices)
+{
+    // Ordenados, cada arista vi-vj (i < j) va a la lista de vi, que es el extremo menor
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+    const size_t k = vertices.size();
+
+    // Se reserva todo de una vez para no crecer arista por arista
+    conjunto.reservar(static_cast<size_t>(aristas) + (k > 1 ? k * (k - 1) / 2 : 0));
+
+    LoteAristas lote;
+    for (size_t i = 0; i < k; ++i) {
+        const int v = vertices[i];
+        aristasSalientes.reservar(v, static_cast<int>(aristasSalientes.lista(v).size() + (k - i - 1)));
+        int agregadas = 0;
+        for (size_t j = i + 1; j < k; ++j) {
+            const int w = vertices[j];
+            if (conjunto.insertar(v, w)) {
+                aristasSalientes.agregar(v, w);
+                ++grados[v];
+                ++grados[w];
+                ++agregadas;
+            }
+        }
+        if (agregadas > 0) {
+            lote.vertices.push_back(v);
+            lote.agregadas.push_back(agregadas);
+            aristas += agregadas;
+        }
+    }
+    if (!lote.vertices.empty()) {
+        csrValida = false;
+        ++cambios;
+    }
+    return lote;
+}
+
+Grafo::LoteAristas Grafo::conectarAristas(std::vector<int> &lista)
+{
+    // Cada par queda como (menor, mayor) y se ordenan: las aristas de una misma lista quedan juntas
+    std::vector<std::pair<int, int>> pares;
+    pares.reserve(lista.size() / 2);
+    for (size_t i = 0; i + 1 < lista.size(); i += 2) {
+        if (lista[i] != lista[i + 1]) {
+            pares.emplace_back(std::min(lista[i], lista[i + 1]), std::max(lista[i], lista[i + 1]));
+        }
+    }
+    std::sort(pares.begin(), pares.end());
+    pares.erase(std::unique(pares.begin(), pares.end()), pares.end());
+    conjunto.reservar(static_cast<size_t>(aristas) + pares.size());
+
+    LoteAristas lote;
+    lista.clear();
+    for (const auto &par : pares) {
+        const int v = par.first, w = par.second;
+        if (!conjunto.insertar(v, w)) {
+            continue; // Ya existía en el grafo
+        }
+        aristasSalientes.agregar(v, w);
+        ++grados[v];
+        ++grados[w];
+        ++aristas;
+        lista.push_back(v);
+        lista.push_back(w);
+        if (lote.vertices.empty() || lote.vertices.back() != v) {
+            lote.vertices.push_back(v);
+            lote.agregadas.push_back(0);
+        }
+        ++lote.agregadas.back();
+    }
+    if (!lote.vertices.empty()) {
+        csrValida = false;
+        ++cambios;
+    }
+    return lote;
+}
+
+void Grafo::deshacerLote(const LoteAristas &lote)
+{
+    for (size_t i = 0; i < lote.vertices.size(); ++i) {
+        const int v = lote.vertices[i];
+        for (int c = 0; c < lote.agregadas[i]; ++c) {
+            const int w = aristasSalientes.quitarUltimo(v); // Las aristas del lote son las últimas de la lista
+            conjunto.quitar(v, w);
+            --grados[v];
+            --grados[w];
+            --aristas;
+        }
+    }
+    if (!lote.vertices.empty()) {
+        csrValida = false;
+        ++cambios;
+    }
+}
+
+const Grafo::CSR &Grafo::csr() const
+{
+    if (csrValida) {
+        return cacheCSR;
+    }
+
+    // Los grados dan los desplazamientos; luego cada arista se escribe en sus dos extremos
+    const int n = cantidadVertices();
+    cacheCSR.inicio.resize(n + 1);
+    cacheCSR.inicio[0] = 0;
+    for (int v = 0; v < n; ++v) {
+        cacheCSR.inicio[v + 1] = cacheCSR.inicio[v] + grados[v];
+    }
+    cacheCSR.vecinos.resize(2 * static_cast<size_t>(aristas));
+    std::vector<int> siguiente(cacheCSR.inicio.begin(), cacheCSR.inicio.end() - 1);
+    for (int v = 0; v < n; ++v) {
+        for (int w : aristasSalientes.lista(v)) {
+            cacheCSR.vecinos[siguiente[v]++] = w;
+            cacheCSR.vecinos[siguiente[w]++] = v;
+        }
+    }
+    csrValida = true;
+    return cacheCSR;
+}
@@ -0,0 +1,94 @@
+#ifndef GRAFO_H
+#define GRAFO_H
+
+#include <cstdint>
+#include <vector>
+
+#include "conjuntoaristas.h"
+#include "pooladyacencia.h"
+
+// Vista de solo lectura de una adyacencia CSR; los algoritmos trabajan sobre
+// ella, así sirven igual para un Grafo que para datos cargados de otra forma
+struct VistaCSR {
+    int n = 0; // Cantidad de vértices
+    const int *inicio = nullptr; // n + 1 desplazamientos
+    const int *vecinos = nullptr; // Vecinos de v en vecinos[inicio[v]] .. vecinos[inicio[v + 1] - 1]
+
+    int grado(int v) const { return inicio[v + 1] - inicio[v]; }
+};
+
+// Clase que guarda el grafo en arreglos contiguos: las posiciones de los
+// vértices van en arreglos separados (x[], y[]) y cada vértice se identifica
+// por un entero estable, su posición en esos arreglos. Cada arista no dirigida
+// se guarda una sola vez, en la lista de su extremo de menor id
+class Grafo {
+public:
+    // Adyacencia compacta en formato CSR: los vecinos de v están en
+    // vecinos[inicio[v]] .. vecinos[inicio[v + 1] - 1]
+    struct CSR {
+        std::vector<int> inicio; // Desplazamiento de cada vértice (tamaño n + 1)
+        std::vector<int> vecinos; // Vecinos de todos los vértices, uno tras otro
+
+        VistaCSR vista() const { return {static_cast<int>(inicio.size()) - 1, inicio.data(), vecinos.data()}; }
+    };
+
+    // Registro compacto de un lote de aristas: en vez de guardar cada par, se
+    // guarda cuántas aristas quedaron al final de la lista de cada vértice.
+    // Ocupa O(k) para una clique de k vértices en lugar de O(k²)
+    struct LoteAristas {
+        std::vector<int> vertices; // Vértices cuya lista recibió aristas nuevas
+        std::vector<int> agregadas; // Cantidad de aristas nuevas al final de cada lista
+    };
+
+    int agregarVertice(double x, double y); // Agrega un vértice y devuelve su id
+    void reservarVertices(int cantidad); // Prepara espacio para cargas masivas
+    void reservarAristas(int cantidad); // Evita rehacer la tabla de aristas durante una carga
+    void eliminarUltimoVertice(); // Quita el vértice de mayor id junto con sus aristas
+    bool conectar(int a, int b); // Conecta dos vértices; devuelve false si ya lo estaban
+    void moverVertice(int v, double x, double y) { xs[v] = x; ys[v] = y; } // Las aristas no cambian
+    void limpiar(); // Elimina todos los vértices y aristas sin liberarlos uno por uno
+
+    // Conecta todos los pares de vértices en una sola pasada; las aristas que ya existían se omiten
+    LoteAristas conectarTodos(std::vector<int> vertices);
+    // Conecta una lista de pares a, b consecutivos en una sola pasada. Omite lazos,
+    // repetidas y las que ya existían, y deja en la lista solo las agregadas, con
+    // a < b y ordenadas (el orden en que quedan en las listas de adyacencia)
+    LoteAristas conectarAristas(std::vector<int> &lista);
+    // Quita las aristas de un lote; debe ser lo último que se agregó a esas listas (orden de deshacer)
+    void deshacerLote(const LoteAristas &lote);
+
+    int cantidadVertices() const { return static_cast<int>(xs.size()); }
+    int cantidadAristas() const { return aristas; }
+
+    double x(int v) const { return xs[v]; }
+    double y(int v) const { return ys[v]; }
+    const std::vector<double> &posicionesX() const { return xs; }
+    const std::vector<double> &posicionesY() const { return ys; }
+
+    int grado(int v) const { return grados[v]; }
+
+    // Cambia cada vez que se agregan o quitan vértices o aristas (mover un vértice
+    // no cuenta); sirve para saber si un resultado calculado sobre el grafo sigue vigente
+    std::uint64_t version() const { return cambios; }
+
+    // Aristas v-w con w > v; recorrer estas listas para todo v visita cada arista una vez
+    PoolAdyacencia::Lista aristasDe(int v) const { return aristasSalientes.lista(v); }
+
+    // Devuelve la adyacencia simétrica en CSR (cada arista aparece en sus dos
+    // extremos) para los recorridos; se reconstruye solo si el grafo cambió
+    const CSR &csr() const;
+
+private:
+    std::vector<double> xs; // Coordenada x de cada vértice
+    std::vector<double> ys; // Coordenada y de cada vértice
+    PoolAdyacencia aristasSalientes; // Extremo mayor de cada arista, en la lista del menor
+    std::vector<int> grados; // Cantidad de aristas incidentes en cada vértice
+    ConjuntoAristas conjunto; // Todas las aristas, para saber en O(1) si una ya existe
+    int aristas = 0; // Cantidad de aristas no dirigidas
+    std::uint64_t cambios = 0; // Modificaciones desde que se creó el grafo
+
+    mutable CSR cacheCSR; // Última CSR construida
+    mutable bool csrValida = false; // Falso cuando el grafo cambió desde la última construcción
+};
+
+#endif // GRAFO_H
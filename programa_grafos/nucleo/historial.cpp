@@ -0,0 +1,150 @@
+#include "historial.h"
+
+#include <utility>
+
+Historial::Historial(size_t limiteBytes)
+    : limiteBytes(limiteBytes)
+{
+}
+
+Historial::Comando Historial::agregarVertice(double x, double y)
+{
+    Comando comando;
+    comando.tipo = TipoComando::AgregarVertice;
+    comando.x = x;
+    comando.y = y;
+    return comando;
+}
+
+Historial::Comando Historial::conectarLote(const std::vector<int> &vertices, const Grafo::LoteAristas &lote)
+{
+    Comando comando;
+    comando.tipo = TipoComando::ConectarLote;
+    comando.datos.reserve(1 + vertices.size() + 2 * lote.vertices.size());
+    comando.datos.push_back(static_cast<int>(vertices.size()));
+    comando.datos.insert(comando.datos.end(), vertices.begin(), vertices.end());
+    actualizarLote(comando, lote);
+    return comando;
+}
+
+Historial::Comando Historial::conectarAristas(const std::vector<int> &aristas)
+{
+    Comando comando;
+    comando.tipo = TipoComando::ConectarAristas;
+    comando.datos = aristas;
+    return comando;
+}
+
+std::vector<int> Historial::verticesDe(const Comando &comando)
+{
+    const int k = comando.datos[0];
+    return std::vector<int>(comando.datos.begin() + 1, comando.datos.begin() + 1 + k);
+}
+
+Grafo::LoteAristas Historial::loteDe(const Comando &comando)
+{
+    Grafo::LoteAristas lote;
+    if (comando.tipo == TipoComando::ConectarAristas) {
+        // Los pares están ordenados por su extremo menor: se cuentan los de cada lista
+        for (size_t i = 0; i + 1 < comando.datos.size(); i += 2) {
+            if (lote.vertices.empty() || lote.vertices.back() != comando.datos[i]) {
+                lote.vertices.push_back(comando.datos[i]);
+                lote.agregadas.push_back(0);
+            }
+            ++lote.agregadas.back();
+        }
+        return lote;
+    }
+    for (size_t i = 1 + comando.datos[0]; i + 1 < comando.datos.size(); i += 2) {
+        lote.vertices.push_back(comando.datos[i]);
+        lote.agregadas.push_back(comando.datos[i + 1]);
+    }
+    return lote;
+}
+
+void Historial::actualizarLote(Comando &comando, const Grafo::LoteAristas &lote)
+{
+    comando.datos.resize(1 + comando.datos[0]); // Se conservan los vértices conectados
+    for (size_t i = 0; i < lote.vertices.size(); ++i) {
+        comando.datos.push_back(lote.vertices[i]);
+        comando.datos.push_back(lote.agregadas[i]);
+    }
+    comando.datos.shrink_to_fit();
+}
+
+void Historial::registrar(Comando comando)
+{
+    // Un cambio nuevo invalida lo que se podía rehacer
+    for (const Comando &c : deshechos) {
+        bytes -= tamano(c);
+    }
+    deshechos.clear();
+
+    bytes += tamano(comando);
+    hechos.push_back(std::move(comando));
+    recortar();
+}
+
+bool Historial::deshacer(const std::function<void(Comando &)> &revertir)
+{
+    if (hechos.empty()) {
+        return false;
+    }
+
+    revertir(hechos.back());
+    deshechos.push_back(std::move(hechos.back()));
+    hechos.pop_back();
+    return true;
+}
+
+bool Historial::rehacer(const std::function<void(Comando &)> &aplicar)
+{
+    if (deshechos.empty()) {
+        return false;
+    }
+
+    Comando &comando = deshechos.back();
+    bytes -= tamano(comando);
+    aplicar(comando); // Puede cambiar el lote guardado, así que se vuelve a medir
+    bytes += tamano(comando);
+    hechos.push_back(std::move(comando));
+    deshechos.pop_back();
+    recortar();
+    return true;
+}
+
+void Historial::limpiar()
+{
+    hechos.clear();
+    deshechos.clear();
+    bytes = 0;
+    descartados = 0;
+}
+
+void Historial::setLimiteBytes(size_t limite)
+{
+    limiteBytes = limite;
+    recortar();
+}
+
+int Historial::tomarDescartados()
+{
+    const int cantidad = descartados;
+    descartados = 0;
+    return cantidad;
+}
+
+size_t Historial::tamano(const Comando &comando)
+{
+    return sizeof(Comando) + comando.datos.capacity() * sizeof(int);
+}
+
+void Historial::recortar()
+{
+    // Se descartan comandos desde el más antiguo, pero nunca el último
+    while (bytes > limiteBytes && hechos.size() > 1) {
+        bytes -= tamano(hechos.front());
+        hechos.pop_front();
+        ++descartados;
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef HISTORIAL_H
+#define HISTORIAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "grafo.h"
+
+// Clase que guarda el historial de deshacer/rehacer con comandos compactos
+// (ids de vértices, nunca punteros). Una conexión en lote es un solo comando,
+// así que se deshace y rehace entera; si el historial supera el límite de
+// memoria se descartan los comandos más antiguos
+class Historial {
+public:
+    // Tipos de comando que se pueden registrar
+    enum class TipoComando : std::uint8_t {
+        AgregarVertice, // Se agregó el vértice de mayor id en (x, y)
+        ConectarLote, // Se conectó un grupo de vértices entre sí
+        ConectarAristas // Se agregó una lista de aristas cualquiera
+    };
+
+    // Comando guardado; solo los de conexión usan memoria dinámica
+    struct Comando {
+        TipoComando tipo;
+        double x = 0; // Posición del vértice (AgregarVertice)
+        double y = 0;
+        // ConectarLote: [k, k vértices conectados, pares (vértice, aristas agregadas)...]
+        // ConectarAristas: pares a, b de las aristas agregadas, como los deja Grafo::conectarAristas
+        std::vector<int> datos;
+    };
+
+    explicit Historial(size_t limiteBytes = 64u * 1024u * 1024u);
+
+    // Crea los comandos empaquetados
+    static Comando agregarVertice(double x, double y);
+    static Comando conectarLote(const std::vector<int> &vertices, const Grafo::LoteAristas &lote);
+    static Comando conectarAristas(const std::vector<int> &aristas);
+
+    // Desempaquetan un ConectarLote; loteDe sirve también para un ConectarAristas
+    static std::vector<int> verticesDe(const Comando &comando);
+    static Grafo::LoteAristas loteDe(const Comando &comando);
+    static void actualizarLote(Comando &comando, const Grafo::LoteAristas &lote); // Tras rehacerlo
+
+    void registrar(Comando comando); // Agrega un comando ya aplicado y descarta lo que se podía rehacer
+
+    // Deshace el último comando llamando a revertir con él
+    bool deshacer(const std::function<void(Comando &)> &revertir);
+    // Rehace el último comando deshecho llamando a aplicar con él
+    bool rehacer(const std::function<void(Comando &)> &aplicar);
+
+    bool puedeDeshacer() const { return !hechos.empty(); }
+    bool puedeRehacer() const { return !deshechos.empty(); }
+    void limpiar();
+
+    void setLimiteBytes(size_t limite); // Cambia el límite y descarta lo que sobre
+    size_t bytesUsados() const { return bytes; }
+    // Comandos descartados por el límite desde la llamada anterior, para que
+    // quien guarde algo por cada comando descarte lo suyo
+    int tomarDescartados();
+
+private:
+    static size_t tamano(const Comando &comando); // Memoria aproximada de un comando
+    void recortar(); // Descarta los comandos más antiguos hasta respetar el límite
+
+    std::deque<Comando> hechos; // Comandos que se pueden deshacer; el más nuevo al final
+    std::vector<Comando> deshechos; // Comandos que se pueden rehacer; el próximo al final
+    size_t limiteBytes; // Memoria máxima del historial
+    size_t bytes = 0; // Memoria usada por hechos y deshechos
+    int descartados = 0; // Comandos descartados que todavía no se informaron
+};
+
+#endif // HISTORIAL_H
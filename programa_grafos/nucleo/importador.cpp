@@ -0,0 +1,603 @@
+#include "importador.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+const size_t tamanoBloque = 1u << 20; // Bytes pedidos en cada lectura
+
+// Posición de los vértices que el archivo no ubica: espiral de Vogel alrededor
+// del centro de la ventana inicial, con la misma densidad sin importar cuántos haya
+void posicionInicial(int i, double &x, double &y)
+{
+    const double separacion = 12; // Distancia media entre vecinos de la espiral
+    const double anguloAureo = 2.399963229728653;
+    const double radio = separacion * std::sqrt(static_cast<double>(i));
+    x = 400 + radio * std::cos(i * anguloAureo);
+    y = 300 + radio * std::sin(i * anguloAureo);
+}
+
+// Junta vértices y aristas y entrega el lote cada vez que se llena
+class Acumulador {
+public:
+    Acumulador(const std::function<void(LoteImportado &)> &entregar, size_t tamanoLote)
+        : entregar(entregar), tamanoLote(tamanoLote) {}
+
+    int cantidadVertices() const { return vertices; }
+
+    // Agrega un vértice y devuelve su id; sin posición se ubica en la espiral
+    int agregarVertice(double x, double y)
+    {
+        lote.x.push_back(x);
+        lote.y.push_back(y);
+        const int id = vertices++;
+        revisar();
+        return id;
+    }
+
+    int agregarVertice()
+    {
+        double x = 0, y = 0;
+        posicionInicial(vertices, x, y);
+        return agregarVertice(x, y);
+    }
+
+    // Da su posición a un vértice ya agregado; si ya se entregó, el cambio va en el lote siguiente
+    void ubicarVertice(int id, double x, double y)
+    {
+        const int primero = vertices - static_cast<int>(lote.x.size()); // Primer id del lote abierto
+        if (id >= primero) {
+            lote.x[id - primero] = x;
+            lote.y[id - primero] = y;
+            return;
+        }
+        lote.reubicados.push_back(id);
+        lote.reubicadosX.push_back(x);
+        lote.reubicadosY.push_back(y);
+        revisar();
+    }
+
+    void agregarArista(int a, int b)
+    {
+        lote.aristas.push_back(a);
+        lote.aristas.push_back(b);
+        revisar();
+    }
+
+    void avanzar(long long bytes) { bytesLeidos = bytes; }
+
+    // Entrega lo que quede al terminar el archivo
+    void terminar()
+    {
+        if (!lote.x.empty() || !lote.aristas.empty() || !lote.reubicados.empty()) {
+            entregarLote();
+        }
+    }
+
+private:
+    void revisar()
+    {
+        if (lote.x.size() + lote.aristas.size() / 2 + lote.reubicados.size() >= tamanoLote) {
+            entregarLote();
+        }
+    }
+
+    void entregarLote()
+    {
+        lote.bytesLeidos = bytesLeidos;
+        entregar(lote);
+        lote.x.clear(); // entregar pudo mover los arreglos
+        lote.y.clear();
+        lote.aristas.clear();
+        lote.reubicados.clear();
+        lote.reubicadosX.clear();
+        lote.reubicadosY.clear();
+    }
+
+    const std::function<void(LoteImportado &)> &entregar;
+    size_t tamanoLote;
+    LoteImportado lote;
+    int vertices = 0; // Vértices entregados o pendientes
+    long long bytesLeidos = 0;
+};
+
+// Lee la entrada por bloques y le pasa a procesar todo lo pendiente; procesar
+// indica cuántos bytes consumió y el resto se conserva para el siguiente bloque
+template <typename Procesar>
+bool leerPorBloques(std::istream &entrada, Acumulador &acumulador, const std::atomic<bool> *cancelar,
+                    std::string &error, Procesar procesar)
+{
+    std::string pendiente;
+    long long leidos = 0;
+    bool final = false;
+    while (!final) {
+        if (cancelar && cancelar->load(std::memory_order_relaxed)) {
+            error = "importación cancelada";
+            return false;
+        }
+        const size_t previo = pendiente.size();
+        pendiente.resize(previo + tamanoBloque);
+        entrada.read(&pendiente[previo], static_cast<std::streamsize>(tamanoBloque));
+        const size_t cantidad = static_cast<size_t>(entrada.gcount());
+        pendiente.resize(previo + cantidad);
+        final = cantidad < tamanoBloque;
+        leidos += static_cast<long long>(cantidad);
+        acumulador.avanzar(leidos);
+
+        size_t consumido = 0;
+        if (!procesar(pendiente.data(), pendiente.data() + pendiente.size(), final, consumido)) {
+            return false;
+        }
+        pendiente.erase(0, consumido);
+    }
+    if (entrada.bad()) {
+        error = "error al leer el archivo";
+        return false;
+    }
+    return true;
+}
+
+// Pasa a linea cada línea completa de [inicio, fin); al final del archivo
+// también la última, aunque no termine en salto de línea
+template <typename Linea>
+bool procesarLineas(const char *inicio, const char *fin, bool final, size_t &consumido, long &numeroLinea,
+                    Linea linea)
+{
+    const char *cursor = inicio;
+    while (cursor < fin) {
+        const char *salto = static_cast<const char *>(std::memchr(cursor, '\n', static_cast<size_t>(fin - cursor)));
+        if (!salto) {
+            if (!final) {
+                break; // La línea sigue en el próximo bloque
+            }
+            salto = fin;
+        }
+        ++numeroLinea;
+        if (!linea(cursor, salto)) {
+            return false;
+        }
+        cursor = salto == fin ? fin : salto + 1;
+    }
+    consumido = static_cast<size_t>(cursor - inicio);
+    return true;
+}
+
+void saltarEspacios(const char *&cursor, const char *fin)
+{
+    while (cursor < fin && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+        ++cursor;
+    }
+}
+
+// Lee un entero sin pasar del fin de la línea; acepta comas como separador.
+// Con signo acepta un '-' delante; sin signo el entero es no negativo
+bool leerEntero(const char *&cursor, const char *fin, long long &valor, bool conSigno = false)
+{
+    saltarEspacios(cursor, fin);
+    if (cursor < fin && *cursor == ',') {
+        ++cursor;
+        saltarEspacios(cursor, fin);
+    }
+    const bool negativo = conSigno && cursor < fin && *cursor == '-';
+    if (negativo) {
+        ++cursor;
+    }
+    const char *digitos = cursor;
+    valor = 0;
+    while (cursor < fin && *cursor >= '0' && *cursor <= '9' && cursor - digitos < 18) {
+        valor = valor * 10 + (*cursor - '0');
+        ++cursor;
+    }
+    if (negativo) {
+        valor = -valor;
+    }
+    return cursor > digitos && (cursor == fin || *cursor < '0' || *cursor > '9');
+}
+
+std::string errorEnLinea(long numeroLinea, const char *mensaje)
+{
+    return "línea " + std::to_string(numeroLinea) + ": " + mensaje;
+}
+
+// Lista de aristas: los ids pueden ser cualquier entero de hasta 18 cifras, incluso
+// negativo; se numeran en orden de aparición
+bool importarListaAristas(std::istream &entrada, Acumulador &acumulador, const std::atomic<bool> *cancelar,
+                          std::string &error)
+{
+    std::unordered_map<long long, int> ids;
+    auto vertice = [&](long long id) {
+        auto [it, nuevo] = ids.try_emplace(id, 0);
+        if (nuevo) {
+            it->second = acumulador.agregarVertice();
+        }
+        return it->second;
+    };
+
+    long numeroLinea = 0;
+    auto linea = [&](const char *cursor, const char *fin) {
+        saltarEspacios(cursor, fin);
+        if (cursor == fin || *cursor == '#' || *cursor == '%') {
+            return true; // Línea vacía o comentario
+        }
+        long long a = 0, b = 0;
+        if (!leerEntero(cursor, fin, a, true) || !leerEntero(cursor, fin, b, true)) {
+            error = errorEnLinea(numeroLinea, "se esperaba 'a b'");
+            return false;
+        }
+        const int va = vertice(a);
+        acumulador.agregarArista(va, vertice(b));
+        return true;
+    };
+    return leerPorBloques(entrada, acumulador, cancelar, error,
+                          [&](const char *inicio, const char *fin, bool final, size_t &consumido) {
+                              return procesarLineas(inicio, fin, final, consumido, numeroLinea, linea);
+                          });
+}
+
+// DIMACS: la línea p declara los vértices 1..n antes de cualquier arista
+bool importarDimacs(std::istream &entrada, Acumulador &acumulador, const std::atomic<bool> *cancelar,
+                    std::string &error)
+{
+    long long n = -1; // Vértices declarados; -1 hasta leer la línea p
+    long numeroLinea = 0;
+    auto linea = [&](const char *cursor, const char *fin) {
+        saltarEspacios(cursor, fin);
+        if (cursor == fin || *cursor == 'c') {
+            return true; // Línea vacía o comentario
+        }
+        const char tipo = *cursor++;
+        if (tipo == 'p') {
+            if (n >= 0) {
+                error = errorEnLinea(numeroLinea, "la línea p está repetida");
+                return false;
+            }
+            saltarEspacios(cursor, fin);
+            while (cursor < fin && *cursor != ' ' && *cursor != '\t') {
+                ++cursor; // Nombre del problema: edge, col, sp...
+            }
+            long long m = 0;
+            if (!leerEntero(cursor, fin, n) || !leerEntero(cursor, fin, m) || n > 0x7ffffffe) {
+                error = errorEnLinea(numeroLinea, "se esperaba 'p edge n m'");
+                return false;
+            }
+            for (long long v = 0; v < n; ++v) {
+                acumulador.agregarVertice();
+            }
+        } else if (tipo == 'e' || tipo == 'a') {
+            long long a = 0, b = 0;
+            if (n < 0) {
+                error = errorEnLinea(numeroLinea, "arista antes de la línea p");
+                return false;
+            }
+            if (!leerEntero(cursor, fin, a) || !leerEntero(cursor, fin, b)) {
+                error = errorEnLinea(numeroLinea, "se esperaba 'e a b'");
+                return false;
+            }
+            if (a < 1 || b < 1 || a > n || b > n) {
+                error = errorEnLinea(numeroLinea, "la arista usa un vértice no declarado");
+                return false;
+            }
+            acumulador.agregarArista(static_cast<int>(a - 1), static_cast<int>(b - 1));
+        } else {
+            error = errorEnLinea(numeroLinea, "tipo de línea desconocido");
+            return false;
+        }
+        return true;
+    };
+    return leerPorBloques(entrada, acumulador, cancelar, error,
+                          [&](const char *inicio, const char *fin, bool final, size_t &consumido) {
+                              return procesarLineas(inicio, fin, final, consumido, numeroLinea, linea);
+                          });
+}
+
+// Lector de GraphML por etiquetas, sin construir un árbol del documento.
+// Solo interpreta key, node, data y edge; el resto se ignora
+class LectorGraphML {
+public:
+    explicit LectorGraphML(Acumulador &acumulador) : acumulador(acumulador) {}
+
+    bool procesar(const char *inicio, const char *fin, bool final, size_t &consumido, std::string &error)
+    {
+        const char *cursor = inicio;
+        while (cursor < fin) {
+            const char *abre = static_cast<const char *>(std::memchr(cursor, '<', static_cast<size_t>(fin - cursor)));
+            if (!abre) {
+                if (enDato) {
+                    texto.append(cursor, fin);
+                }
+                cursor = fin;
+                break;
+            }
+            if (enDato) {
+                texto.append(cursor, abre);
+            }
+            cursor = abre;
+
+            if (fin - abre >= 4 && std::memcmp(abre, "<!--", 4) == 0) {
+                const char *finComentario = buscar(abre + 4, fin, "-->");
+                if (!finComentario) {
+                    if (final) {
+                        error = "comentario sin cerrar";
+                        return false;
+                    }
+                    break;
+                }
+                cursor = finComentario + 3;
+                continue;
+            }
+            const char *cierra = static_cast<const char *>(std::memchr(abre, '>', static_cast<size_t>(fin - abre)));
+            if (!cierra) {
+                if (final) {
+                    error = "etiqueta sin cerrar";
+                    return false;
+                }
+                break; // La etiqueta sigue en el próximo bloque
+            }
+            if (!etiqueta(abre + 1, cierra, error)) {
+                return false;
+            }
+            cursor = cierra + 1;
+        }
+        consumido = static_cast<size_t>(cursor - inicio);
+        return true;
+    }
+
+private:
+    static const char *buscar(const char *inicio, const char *fin, const char *patron)
+    {
+        const size_t largo = std::strlen(patron);
+        for (const char *c = inicio; c + largo <= fin; ++c) {
+            if (std::memcmp(c, patron, largo) == 0) {
+                return c;
+            }
+        }
+        return nullptr;
+    }
+
+    static bool esEspacio(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    // Separa el nombre y los atributos de la etiqueta [cursor, fin) ya sin '<' ni '>'
+    void leerAtributos(const char *cursor, const char *fin)
+    {
+        atributos.clear();
+        while (cursor < fin) {
+            while (cursor < fin && (esEspacio(*cursor) || *cursor == '/')) {
+                ++cursor;
+            }
+            const char *nombre = cursor;
+            while (cursor < fin && *cursor != '=' && !esEspacio(*cursor)) {
+                ++cursor;
+            }
+            const char *finNombre = cursor;
+            while (cursor < fin && esEspacio(*cursor)) {
+                ++cursor;
+            }
+            if (cursor == fin || *cursor != '=') {
+                continue; // Atributo sin valor
+            }
+            ++cursor;
+            while (cursor < fin && esEspacio(*cursor)) {
+                ++cursor;
+            }
+            if (cursor == fin || (*cursor != '"' && *cursor != '\'')) {
+                continue;
+            }
+            const char comilla = *cursor++;
+            const char *valor = cursor;
+            while (cursor < fin && *cursor != comilla) {
+                ++cursor;
+            }
+            atributos.emplace_back(std::string(nombre, finNombre), std::string(valor, cursor));
+            if (cursor < fin) {
+                ++cursor;
+            }
+        }
+    }
+
+    const std::string *atributo(const char *nombre) const
+    {
+        for (const auto &par : atributos) {
+            if (par.first == nombre) {
+                return &par.second;
+            }
+        }
+        return nullptr;
+    }
+
+    int vertice(const std::string &id)
+    {
+        auto [it, nuevo] = ids.try_emplace(id, 0);
+        if (nuevo) {
+            it->second = acumulador.agregarVertice();
+        }
+        return it->second;
+    }
+
+    bool etiqueta(const char *cursor, const char *fin, std::string &error)
+    {
+        if (cursor == fin || *cursor == '?' || *cursor == '!') {
+            return true; // Declaración XML, DOCTYPE o CDATA
+        }
+        const bool cierre = *cursor == '/';
+        if (cierre) {
+            ++cursor;
+        }
+        const bool autocierre = fin[-1] == '/';
+        const char *nombre = cursor;
+        while (cursor < fin && !esEspacio(*cursor) && *cursor != '/') {
+            ++cursor;
+        }
+        const std::string tipo(nombre, cursor);
+
+        if (cierre) {
+            if (tipo == "data" && enDato) {
+                enDato = false;
+                const double valor = std::strtod(texto.c_str(), nullptr);
+                if (!std::isfinite(valor)) {
+                    // NaN además significa "sin posición" en definirNodo
+                    error = "el nodo " + nodoActual + " tiene una coordenada no finita";
+                    return false;
+                }
+                (ejeDato == 0 ? posicionX : posicionY) = valor;
+            } else if (tipo == "node" && enNodo) {
+                enNodo = false;
+                definirNodo();
+            }
+            return true;
+        }
+
+        leerAtributos(cursor, fin);
+        if (tipo == "key") {
+            const std::string *id = atributo("id");
+            const std::string *nombreAtributo = atributo("attr.name");
+            const std::string *para = atributo("for");
+            if (id && nombreAtributo && (!para || *para == "node" || *para == "all")) {
+                if (*nombreAtributo == "x") {
+                    claves[*id] = 0;
+                } else if (*nombreAtributo == "y") {
+                    claves[*id] = 1;
+                }
+            }
+        } else if (tipo == "node") {
+            const std::string *id = atributo("id");
+            if (!id) {
+                error = "nodo sin id";
+                return false;
+            }
+            nodoActual = *id;
+            posicionX = posicionY = NAN;
+            if (autocierre) {
+                definirNodo();
+            } else {
+                enNodo = true;
+            }
+        } else if (tipo == "data" && enNodo && !autocierre) {
+            const std::string *clave = atributo("key");
+            auto it = clave ? claves.find(*clave) : claves.end();
+            if (it != claves.end()) {
+                enDato = true;
+                ejeDato = it->second;
+                texto.clear();
+            }
+        } else if (tipo == "edge") {
+            const std::string *origen = atributo("source");
+            const std::string *destino = atributo("target");
+            if (!origen || !destino) {
+                error = "arista sin source o target";
+                return false;
+            }
+            const int a = vertice(*origen);
+            acumulador.agregarArista(a, vertice(*destino));
+        }
+        return true;
+    }
+
+    // Crea el vértice del nodo que se acaba de leer. Si una arista ya lo creó en la
+    // espiral, le da la posición del nodo; si el nodo está repetido vale el primero
+    void definirNodo()
+    {
+        const bool conPosicion = !std::isnan(posicionX) && !std::isnan(posicionY);
+        auto [it, nuevo] = ids.try_emplace(std::move(nodoActual), 0);
+        if (nuevo) {
+            it->second = conPosicion ? acumulador.agregarVertice(posicionX, posicionY) : acumulador.agregarVertice();
+        }
+        declarados.resize(acumulador.cantidadVertices(), false);
+        if (declarados[it->second]) {
+            return;
+        }
+        if (!nuevo && conPosicion) {
+            acumulador.ubicarVertice(it->second, posicionX, posicionY);
+        }
+        declarados[it->second] = true;
+    }
+
+    Acumulador &acumulador;
+    std::unordered_map<std::string, int> ids; // Id del archivo -> id del grafo
+    std::vector<bool> declarados; // Por id del grafo: ya se leyó su <node>
+    std::unordered_map<std::string, int> claves; // Clave de <data> -> 0 para x, 1 para y
+    std::vector<std::pair<std::string, std::string>> atributos; // Atributos de la etiqueta actual
+    std::string nodoActual;
+    double posicionX = NAN;
+    double posicionY = NAN;
+    bool enNodo = false;
+    bool enDato = false; // Dentro de un <data> con x o y
+    int ejeDato = 0;
+    std::string texto; // Contenido del <data> actual
+};
+
+bool terminaEn(const std::string &texto, const char *sufijo)
+{
+    const size_t largo = std::strlen(sufijo);
+    if (texto.size() < largo) {
+        return false;
+    }
+    for (size_t i = 0; i < largo; ++i) {
+        const char c = texto[texto.size() - largo + i];
+        if ((c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c) != sufijo[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool formatoPorExtension(const std::string &ruta, FormatoImportacion &formato)
+{
+    if (terminaEn(ruta, ".graphml")) {
+        formato = FormatoImportacion::GraphML;
+    } else if (terminaEn(ruta, ".col") || terminaEn(ruta, ".dimacs") || terminaEn(ruta, ".gr")) {
+        formato = FormatoImportacion::Dimacs;
+    } else if (terminaEn(ruta, ".txt") || terminaEn(ruta, ".edges") || terminaEn(ruta, ".el")
+               || terminaEn(ruta, ".tsv") || terminaEn(ruta, ".csv")) {
+        formato = FormatoImportacion::ListaAristas;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool importarGrafo(std::istream &entrada, FormatoImportacion formato,
+                   const std::function<void(LoteImportado &)> &entregar, std::string &error,
+                   const std::atomic<bool> *cancelar, size_t tamanoLote)
+{
+    Acumulador acumulador(entregar, tamanoLote);
+    bool correcto = false;
+    switch (formato) {
+    case FormatoImportacion::ListaAristas:
+        correcto = importarListaAristas(entrada, acumulador, cancelar, error);
+        break;
+    case FormatoImportacion::Dimacs:
+        correcto = importarDimacs(entrada, acumulador, cancelar, error);
+        break;
+    case FormatoImportacion::GraphML: {
+        LectorGraphML lector(acumulador);
+        correcto = leerPorBloques(entrada, acumulador, cancelar, error,
+                                  [&](const char *inicio, const char *fin, bool final, size_t &consumido) {
+                                      return lector.procesar(inicio, fin, final, consumido, error);
+                                  });
+        break;
+    }
+    }
+    if (correcto) {
+        acumulador.terminar();
+    }
+    return correcto;
+}
+
+void agregarLoteImportado(Grafo &grafo, const LoteImportado &lote)
+{
+    for (size_t i = 0; i < lote.x.size(); ++i) {
+        grafo.agregarVertice(lote.x[i], lote.y[i]);
+    }
+    for (size_t i = 0; i + 1 < lote.aristas.size(); i += 2) {
+        grafo.conectar(lote.aristas[i], lote.aristas[i + 1]); // Lazos y aristas repetidas se ignoran
+    }
+    for (size_t i = 0; i < lote.reubicados.size(); ++i) {
+        grafo.moverVertice(lote.reubicados[i], lote.reubicadosX[i], lote.reubicadosY[i]);
+    }
+}
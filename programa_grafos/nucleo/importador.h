@@ -0,0 +1,50 @@
+#ifndef IMPORTADOR_H
+#define IMPORTADOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "grafo.h"
+
+// Formatos de otros programas que se pueden importar
+enum class FormatoImportacion {
+    ListaAristas, // "a b" por línea; # y % comentan; columnas extra (pesos) se ignoran
+    Dimacs, // "c" comentario, "p edge n m", "e a b" con ids desde 1
+    GraphML // <node id>, <edge source target>; posiciones en <data> de claves "x"/"y"
+};
+
+// Elige el formato según la extensión del archivo; devuelve false si no la reconoce
+bool formatoPorExtension(const std::string &ruta, FormatoImportacion &formato);
+
+// Parte de un grafo importado. Los vértices nuevos reciben ids consecutivos a
+// continuación de los de lotes anteriores; las aristas pueden usar cualquier
+// vértice ya entregado o de este mismo lote
+struct LoteImportado {
+    std::vector<double> x; // Posición de cada vértice nuevo, en orden de id
+    std::vector<double> y;
+    std::vector<int> aristas; // Pares a, b consecutivos
+    // Vértices de lotes anteriores que el archivo ubicó recién ahora (en GraphML una
+    // arista puede nombrar un nodo antes de su <node>), con su posición definitiva
+    std::vector<int> reubicados;
+    std::vector<double> reubicadosX;
+    std::vector<double> reubicadosY;
+    long long bytesLeidos = 0; // Avance en el archivo al cerrar el lote
+};
+
+// Lee el archivo por bloques y entrega el grafo en lotes de a lo sumo
+// tamanoLote elementos, sin esperar a terminar de leerlo. entregar puede
+// mover el contenido del lote. Si cancelar pasa a true se detiene entre
+// bloques. Si hay un error devuelve false y lo describe en error
+bool importarGrafo(std::istream &entrada, FormatoImportacion formato,
+                   const std::function<void(LoteImportado &)> &entregar, std::string &error,
+                   const std::atomic<bool> *cancelar = nullptr, size_t tamanoLote = 65536);
+
+// Agrega un lote al grafo; los ids del lote deben coincidir con los del grafo
+// (el grafo empezó vacío y recibió todos los lotes anteriores)
+void agregarLoteImportado(Grafo &grafo, const LoteImportado &lote);
+
+#endif // IMPORTADOR_H
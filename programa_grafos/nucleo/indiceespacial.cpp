@@ -0,0 +1,130 @@
+#include "indiceespacial.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "vectorial.h"
+
+IndiceEspacial::IndiceEspacial(double tamanoCelda)
+    : tamanoCelda(tamanoCelda)
+{
+}
+
+void IndiceEspacial::insertar(int id, double x, double y)
+{
+    Celda &destino = celdas[clave(celda(x), celda(y))];
+    destino.ids.push_back(id);
+    destino.xs.push_back(x);
+    destino.ys.push_back(y);
+}
+
+void IndiceEspacial::eliminar(int id, double x, double y)
+{
+    auto it = celdas.find(clave(celda(x), celda(y)));
+    if (it == celdas.end()) {
+        return;
+    }
+
+    Celda &origen = it->second;
+    // Se busca desde el final: lo normal es deshacer el último punto agregado
+    for (size_t i = origen.ids.size(); i-- > 0;) {
+        if (origen.ids[i] == id) {
+            origen.ids.erase(origen.ids.begin() + i);
+            origen.xs.erase(origen.xs.begin() + i);
+            origen.ys.erase(origen.ys.begin() + i);
+            break;
+        }
+    }
+    if (origen.ids.empty()) {
+        celdas.erase(it); // No se guardan celdas vacías
+    }
+}
+
+void IndiceEspacial::limpiar()
+{
+    celdas.clear();
+}
+
+int IndiceEspacial::buscar(double x, double y, double radio) const
+{
+    int encontrado = -1;
+    double distanciaEncontrado = 0;
+
+    // Solo se revisan las celdas que cubren el círculo de búsqueda
+    const int cx0 = celda(x - radio), cx1 = celda(x + radio);
+    const int cy0 = celda(y - radio), cy1 = celda(y + radio);
+    for (int cx = cx0; cx <= cx1; ++cx) {
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            auto it = celdas.find(clave(cx, cy));
+            if (it == celdas.end()) {
+                continue;
+            }
+            const Celda &candidatos = it->second;
+            const int i = puntoMasCercano(candidatos.xs.data(), candidatos.ys.data(),
+                                          static_cast<int>(candidatos.ids.size()), x, y, radio);
+            if (i < 0) {
+                continue;
+            }
+            const double dx = candidatos.xs[i] - x, dy = candidatos.ys[i] - y;
+            const double distancia = dx * dx + dy * dy;
+            // Entre celdas también gana el más cercano y, si empatan, el más antiguo
+            if (encontrado < 0 || distancia < distanciaEncontrado
+                || (distancia == distanciaEncontrado && candidatos.ids[i] < encontrado)) {
+                encontrado = candidatos.ids[i];
+                distanciaEncontrado = distancia;
+            }
+        }
+    }
+    return encontrado;
+}
+
+void IndiceEspacial::consultar(double xMin, double yMin, double xMax, double yMax, std::vector<int> &salida) const
+{
+    const size_t inicio = salida.size();
+    auto agregarDentro = [&](const Celda &candidatos) {
+        for (size_t i = 0; i < candidatos.ids.size(); ++i) {
+            if (candidatos.xs[i] >= xMin && candidatos.xs[i] <= xMax && candidatos.ys[i] >= yMin && candidatos.ys[i] <= yMax) {
+                salida.push_back(candidatos.ids[i]);
+            }
+        }
+    };
+
+    const int cx0 = celda(xMin), cx1 = celda(xMax);
+    const int cy0 = celda(yMin), cy1 = celda(yMax);
+    const double celdasRect = (static_cast<double>(cx1) - cx0 + 1) * (static_cast<double>(cy1) - cy0 + 1);
+    if (celdasRect > static_cast<double>(celdas.size())) {
+        // El rectángulo cubre más celdas de las que hay ocupadas: es más barato recorrer las ocupadas
+        for (const auto &par : celdas) {
+            agregarDentro(par.second);
+        }
+    } else {
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            for (int cy = cy0; cy <= cy1; ++cy) {
+                auto it = celdas.find(clave(cx, cy));
+                if (it != celdas.end()) {
+                    agregarDentro(it->second);
+                }
+            }
+        }
+    }
+    // Orden de inserción, para que los puntos superpuestos se dibujen igual que antes
+    std::sort(salida.begin() + inicio, salida.end());
+}
+
+int IndiceEspacial::celda(double coordenada) const
+{
+    // Se satura lejos de los extremos de int: convertir un valor fuera de rango
+    // es indefinido, y los recorridos de cx0 a cx1 no deben desbordar al avanzar
+    const double limite = 1 << 30;
+    const double indice = std::floor(coordenada / tamanoCelda);
+    if (std::isnan(indice)) {
+        return 0;
+    }
+    return static_cast<int>(std::min(std::max(indice, -limite), limite));
+}
+
+std::uint64_t IndiceEspacial::clave(int cx, int cy)
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32)
+           | static_cast<std::uint32_t>(cy);
+}
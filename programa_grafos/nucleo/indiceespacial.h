@@ -0,0 +1,42 @@
+#ifndef INDICEESPACIAL_H
+#define INDICEESPACIAL_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Clase que indexa los puntos del grafo en una rejilla uniforme para
+// encontrar el punto bajo el cursor sin recorrer todos los puntos
+class IndiceEspacial {
+public:
+    // Constructor que recibe el lado de cada celda de la rejilla
+    explicit IndiceEspacial(double tamanoCelda = 14.0);
+
+    void insertar(int id, double x, double y); // Agrega un punto a la celda que le corresponde
+    void eliminar(int id, double x, double y); // Quita un punto de su celda
+    void limpiar(); // Vacía el índice por completo
+
+    // Devuelve el punto más cercano a (x, y) a distancia <= radio (el de menor id si
+    // hay empate), o -1 si no hay ninguno
+    int buscar(double x, double y, double radio) const;
+
+    // Agrega a salida los ids de los puntos dentro del rectángulo, en orden creciente
+    void consultar(double xMin, double yMin, double xMax, double yMax, std::vector<int> &salida) const;
+
+private:
+    // Puntos de una celda en arreglos separados, para medir distancias con los
+    // núcleos vectoriales; la posición se copia para no tener que consultar el grafo
+    struct Celda {
+        std::vector<int> ids;
+        std::vector<double> xs;
+        std::vector<double> ys;
+    };
+
+    int celda(double coordenada) const; // Índice de celda para una coordenada
+    static std::uint64_t clave(int cx, int cy); // Clave única de una celda
+
+    double tamanoCelda; // Lado de cada celda
+    std::unordered_map<std::uint64_t, Celda> celdas; // Solo se guardan las celdas ocupadas
+};
+
+#endif // INDICEESPACIAL_H
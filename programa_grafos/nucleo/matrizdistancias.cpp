@@ -0,0 +1,192 @@
+#include "matrizdistancias.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+namespace {
+
+const char magiaMatriz[8] = {'G', 'R', 'A', 'F', 'O', 'D', 'I', 'S'};
+const std::uint32_t versionMatriz = 1;
+
+const int limiteFloyd = 2048; // Floyd–Warshall guarda n² distancias: solo para grafos chicos
+const int ladoBloque = 64; // Un bloque de 64x64 distancias de 4 bytes cabe en la caché L1
+const size_t bytesPorTanda = 32u * 1024u * 1024u; // Memoria para las filas de cada tanda de BFS
+
+// Fila de distancias desde origen, con un BFS que usa la misma fila como marca de visitado
+template <typename T>
+void filaPorAnchura(const VistaCSR &grafo, int origen, T *fila, int *cola)
+{
+    const T sinCamino = std::numeric_limits<T>::max();
+    std::fill(fila, fila + grafo.n, sinCamino);
+    int frente = 0, fin = 0;
+    cola[fin++] = origen;
+    fila[origen] = 0;
+    while (frente < fin) {
+        const int v = cola[frente++];
+        const T siguiente = static_cast<T>(fila[v] + 1);
+        for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+            const int w = grafo.vecinos[k];
+            if (fila[w] == sinCamino) {
+                fila[w] = siguiente;
+                cola[fin++] = w;
+            }
+        }
+    }
+}
+
+// Calcula las filas por tandas en paralelo y escribe cada tanda apenas termina
+template <typename T>
+bool escribirPorAnchura(const VistaCSR &grafo, PoolHilos &hilos, std::ofstream &salida,
+                        const std::atomic<bool> *cancelar)
+{
+    const int n = grafo.n;
+    if (n == 0) {
+        return true;
+    }
+    const size_t bytesFila = static_cast<size_t>(n) * sizeof(T);
+    const int filasPorTanda = std::min(n, std::max(static_cast<int>(hilos.cantidadHilos()),
+                                                   static_cast<int>(bytesPorTanda / bytesFila)));
+    std::vector<T> tanda(static_cast<size_t>(filasPorTanda) * n);
+    for (int primera = 0; primera < n; primera += filasPorTanda) {
+        if (cancelar && cancelar->load(std::memory_order_relaxed)) {
+            return false;
+        }
+        const int filas = std::min(filasPorTanda, n - primera);
+        hilos.paraCada(filas, [&](int inicio, int fin) {
+            std::vector<int> cola(n); // Una por bloque de filas, no por fila
+            for (int f = inicio; f < fin; ++f) {
+                filaPorAnchura(grafo, primera + f, tanda.data() + static_cast<size_t>(f) * n, cola.data());
+            }
+        });
+        salida.write(reinterpret_cast<const char *>(tanda.data()), static_cast<std::streamsize>(filas * bytesFila));
+    }
+    return true;
+}
+
+// Relaja el bloque (i0, j0) pasando por los intermedios del bloque k0
+void relajarBloque(std::uint32_t *d, int n, int i0, int j0, int k0)
+{
+    const int i1 = std::min(n, i0 + ladoBloque), j1 = std::min(n, j0 + ladoBloque), k1 = std::min(n, k0 + ladoBloque);
+    for (int k = k0; k < k1; ++k) {
+        const std::uint32_t *filaK = d + static_cast<size_t>(k) * n;
+        for (int i = i0; i < i1; ++i) {
+            std::uint32_t *filaI = d + static_cast<size_t>(i) * n;
+            const std::uint32_t ik = filaI[k];
+            for (int j = j0; j < j1; ++j) {
+                filaI[j] = std::min(filaI[j], ik + filaK[j]); // Sin ramas, se vectoriza
+            }
+        }
+    }
+}
+
+// Floyd–Warshall por bloques: en cada ronda se cierra el bloque diagonal,
+// luego su fila y su columna de bloques, y por último el resto en paralelo
+template <typename T>
+bool escribirPorFloyd(const VistaCSR &grafo, PoolHilos &hilos, std::ofstream &salida,
+                      const std::atomic<bool> *cancelar)
+{
+    const int n = grafo.n;
+    const std::uint32_t infinito = 0x3fffffff; // La suma de dos no desborda
+    std::vector<std::uint32_t> d(static_cast<size_t>(n) * n, infinito);
+    for (int v = 0; v < n; ++v) {
+        d[static_cast<size_t>(v) * n + v] = 0;
+        for (int k = grafo.inicio[v]; k < grafo.inicio[v + 1]; ++k) {
+            d[static_cast<size_t>(v) * n + grafo.vecinos[k]] = 1;
+        }
+    }
+
+    const int bloques = (n + ladoBloque - 1) / ladoBloque;
+    for (int kb = 0; kb < bloques; ++kb) {
+        if (cancelar && cancelar->load(std::memory_order_relaxed)) {
+            return false;
+        }
+        const int k0 = kb * ladoBloque;
+        relajarBloque(d.data(), n, k0, k0, k0);
+        hilos.paraCada(bloques, [&](int inicio, int fin) {
+            for (int b = inicio; b < fin; ++b) {
+                if (b != kb) {
+                    relajarBloque(d.data(), n, k0, b * ladoBloque, k0); // Fila de bloques kb
+                    relajarBloque(d.data(), n, b * ladoBloque, k0, k0); // Columna de bloques kb
+                }
+            }
+        }, 1);
+        hilos.paraCada(bloques, [&](int inicio, int fin) {
+            for (int ib = inicio; ib < fin; ++ib) {
+                for (int jb = 0; jb < bloques && ib != kb; ++jb) {
+                    if (jb != kb) {
+                        relajarBloque(d.data(), n, ib * ladoBloque, jb * ladoBloque, k0);
+                    }
+                }
+            }
+        }, 1);
+    }
+
+    // Se escribe fila por fila en el ancho del archivo
+    std::vector<T> fila(n);
+    for (int i = 0; i < n; ++i) {
+        const std::uint32_t *origen = d.data() + static_cast<size_t>(i) * n;
+        for (int j = 0; j < n; ++j) {
+            fila[j] = origen[j] >= infinito ? std::numeric_limits<T>::max() : static_cast<T>(origen[j]);
+        }
+        salida.write(reinterpret_cast<const char *>(fila.data()), static_cast<std::streamsize>(n * sizeof(T)));
+    }
+    return true;
+}
+
+template <typename T>
+bool escribirFilas(const VistaCSR &grafo, PoolHilos &hilos, std::ofstream &salida, MetodoMatriz metodo,
+                   const std::atomic<bool> *cancelar)
+{
+    return metodo == MetodoMatriz::FloydWarshall ? escribirPorFloyd<T>(grafo, hilos, salida, cancelar)
+                                                 : escribirPorAnchura<T>(grafo, hilos, salida, cancelar);
+}
+
+} // namespace
+
+MetodoMatriz elegirMetodoMatriz(const VistaCSR &grafo)
+{
+    // Con grado medio de al menos n / 8, los n BFS cuestan tanto como Floyd–Warshall
+    // y este recorre la memoria en bloques contiguos
+    const long long entradas = grafo.n > 0 ? grafo.inicio[grafo.n] : 0;
+    if (grafo.n <= limiteFloyd && 8 * entradas >= static_cast<long long>(grafo.n) * grafo.n) {
+        return MetodoMatriz::FloydWarshall;
+    }
+    return MetodoMatriz::Anchura;
+}
+
+bool exportarMatrizDistancias(const VistaCSR &grafo, PoolHilos &hilos, const std::string &ruta, std::string &error,
+                              MetodoMatriz metodo, const std::atomic<bool> *cancelar)
+{
+    if (metodo == MetodoMatriz::Automatico) {
+        metodo = elegirMetodoMatriz(grafo);
+    }
+    std::ofstream salida(ruta, std::ios::binary | std::ios::trunc);
+    if (!salida) {
+        error = "no se pudo crear el archivo";
+        return false;
+    }
+
+    const bool corto = grafo.n < 0xffff;
+    CabeceraMatrizDistancias cabecera;
+    std::memcpy(cabecera.magia, magiaMatriz, sizeof(magiaMatriz));
+    cabecera.version = versionMatriz;
+    cabecera.anchoEntrada = corto ? 2 : 4;
+    cabecera.vertices = static_cast<std::uint64_t>(grafo.n);
+    salida.write(reinterpret_cast<const char *>(&cabecera), sizeof(cabecera));
+
+    const bool completo = corto ? escribirFilas<std::uint16_t>(grafo, hilos, salida, metodo, cancelar)
+                                : escribirFilas<std::uint32_t>(grafo, hilos, salida, metodo, cancelar);
+    salida.close();
+    if (!completo) {
+        error = "cancelado";
+        return false;
+    }
+    if (!salida) {
+        error = "no se pudo escribir el archivo";
+        return false;
+    }
+    return true;
+}
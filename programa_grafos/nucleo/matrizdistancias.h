@@ -0,0 +1,40 @@
+#ifndef MATRIZDISTANCIAS_H
+#define MATRIZDISTANCIAS_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "grafo.h"
+#include "poolhilos.h"
+
+// Archivo con la matriz de distancias entre todos los pares (.dist), en el
+// orden de bytes de la máquina:
+//   cabecera (24 bytes): "GRAFODIS", versión, bytes por entrada (2 o 4), n
+//   n filas de n enteros sin signo: la distancia en aristas de la fila a la
+//   columna, o el mayor valor del tipo (0xFFFF / 0xFFFFFFFF) si no hay camino
+// Se usan 2 bytes por entrada mientras n < 65535, así la distancia más larga
+// posible (n - 1) nunca choca con la marca de "sin camino"
+struct CabeceraMatrizDistancias {
+    char magia[8]; // "GRAFODIS" sin terminador
+    std::uint32_t version;
+    std::uint32_t anchoEntrada; // Bytes por entrada
+    std::uint64_t vertices;
+};
+
+enum class MetodoMatriz {
+    Automatico, // Floyd–Warshall para grafos chicos y densos, si no BFS
+    Anchura, // Un BFS por origen, en paralelo; solo unas filas en memoria a la vez
+    FloydWarshall // Por bloques, en paralelo; guarda la matriz completa en memoria
+};
+
+// Método que usaría Automatico para este grafo
+MetodoMatriz elegirMetodoMatriz(const VistaCSR &grafo);
+
+// Calcula las distancias entre todos los pares y las escribe en ruta. Si
+// falla o se cancela devuelve false y lo describe en error
+bool exportarMatrizDistancias(const VistaCSR &grafo, PoolHilos &hilos, const std::string &ruta, std::string &error,
+                              MetodoMatriz metodo = MetodoMatriz::Automatico,
+                              const std::atomic<bool> *cancelar = nullptr);
+
+#endif // MATRIZDISTANCIAS_H
@@ -0,0 +1,524 @@
+#include "modolote.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "algoritmos.h"
+#include "arbolminimo.h"
+#include "caminos.h"
+#include "cliques.h"
+#include "coloreo.h"
+#include "formatobinario.h"
+#include "formatotexto.h"
+#include "grafo.h"
+#include "importador.h"
+#include "matrizdistancias.h"
+#include "poolhilos.h"
+#include "vectorial.h"
+
+namespace {
+
+// Datos que comparten todos los análisis de una ejecución
+struct Contexto {
+    VistaCSR csr;
+    const double *x; // Posiciones de los vértices
+    const double *y;
+    int origen; // Vértice de partida para los recorridos
+    int destino; // Vértice de llegada para el camino más corto
+    std::string rutaMatriz; // Archivo donde se escribe la matriz de distancias
+    long long limiteNodos; // Nodos de búsqueda para clique e independent-set (0: sin límite)
+};
+
+// Alcanza para unos segundos de búsqueda; si se agota el resultado sale con "exacto": false
+const long long limiteNodosPorDefecto = 1000000;
+
+// Escribe un arreglo de enteros en JSON
+void escribirArreglo(std::ostream &salida, const std::vector<int> &valores)
+{
+    salida << '[';
+    for (size_t i = 0; i < valores.size(); ++i) {
+        if (i > 0) {
+            salida << ',';
+        }
+        salida << valores[i];
+    }
+    salida << ']';
+}
+
+// Escribe un real con la representación más corta que se lee de vuelta igual
+void escribirReal(std::ostream &salida, double valor)
+{
+    char texto[32];
+    const std::to_chars_result fin = std::to_chars(texto, texto + sizeof(texto), valor);
+    salida.write(texto, fin.ptr - texto);
+}
+
+// Escribe un arreglo de distancias en JSON; las infinitas (no alcanzables) van como null
+void escribirDistancias(std::ostream &salida, const std::vector<double> &valores)
+{
+    salida << '[';
+    for (size_t i = 0; i < valores.size(); ++i) {
+        if (i > 0) {
+            salida << ',';
+        }
+        if (valores[i] == std::numeric_limits<double>::infinity()) {
+            salida << "null";
+        } else {
+            escribirReal(salida, valores[i]);
+        }
+    }
+    salida << ']';
+}
+
+// Escribe una cadena en JSON escapando comillas, barras y caracteres de control
+void escribirCadena(std::ostream &salida, const std::string &texto)
+{
+    salida << '"';
+    for (unsigned char c : texto) {
+        if (c == '"' || c == '\\') {
+            salida << '\\' << c;
+        } else if (c < 0x20) {
+            const char *hex = "0123456789abcdef";
+            salida << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+        } else {
+            salida << c;
+        }
+    }
+    salida << '"';
+}
+
+double milisegundosDesde(std::chrono::steady_clock::time_point inicio)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+double analizarAnchura(const Contexto &contexto, std::ostream &salida)
+{
+    const auto inicio = std::chrono::steady_clock::now();
+    const std::vector<int> distancia = recorridoAnchura(contexto.csr, contexto.origen);
+    const double tiempo = milisegundosDesde(inicio);
+    int alcanzados = 0, profundidad = 0;
+    for (int d : distancia) {
+        if (d >= 0) {
+            ++alcanzados;
+            profundidad = std::max(profundidad, d);
+        }
+    }
+    salida << "{\"origen\":" << contexto.origen << ",\"alcanzados\":" << alcanzados
+           << ",\"profundidad\":" << profundidad << ",\"distancias\":";
+    escribirArreglo(salida, distancia);
+    salida << '}';
+    return tiempo;
+}
+
+double analizarProfundidad(const Contexto &contexto, std::ostream &salida)
+{
+    const auto inicio = std::chrono::steady_clock::now();
+    const std::vector<int> orden = recorridoProfundidad(contexto.csr, contexto.origen);
+    const double tiempo = milisegundosDesde(inicio);
+    const int alcanzados = static_cast<int>(std::count_if(orden.begin(), orden.end(), [](int o) { return o >= 0; }));
+    salida << "{\"origen\":" << contexto.origen << ",\"alcanzados\":" << alcanzados << ",\"orden\":";
+    escribirArreglo(salida, orden);
+    salida << '}';
+    return tiempo;
+}
+
+double analizarComponentes(const Contexto &contexto, std::ostream &salida)
+{
+    const auto inicio = std::chrono::steady_clock::now();
+    std::vector<int> etiqueta;
+    const int cantidad = componentesConexas(contexto.csr, etiqueta);
+    const double tiempo = milisegundosDesde(inicio);
+    salida << "{\"cantidad\":" << cantidad << ",\"etiquetas\":";
+    escribirArreglo(salida, etiqueta);
+    salida << '}';
+    return tiempo;
+}
+
+// Análisis disponibles en --run; cada uno escribe su resultado como un valor
+// JSON y devuelve cuántos milisegundos tardó el cálculo (sin la escritura)
+double analizarDistancias(const Contexto &contexto, std::ostream &salida)
+{
+    BuscadorCaminos buscador;
+    const auto inicio = std::chrono::steady_clock::now();
+    buscador.distanciasDesde(contexto.csr, contexto.x, contexto.y, contexto.origen);
+    const double tiempo = milisegundosDesde(inicio);
+    std::vector<double> distancias(contexto.csr.n);
+    for (int v = 0; v < contexto.csr.n; ++v) {
+        distancias[v] = buscador.distancia(v);
+    }
+    salida << "{\"origen\":" << contexto.origen << ",\"alcanzados\":" << buscador.verticesVisitados()
+           << ",\"distancias\":";
+    escribirDistancias(salida, distancias);
+    salida << '}';
+    return tiempo;
+}
+
+double analizarCamino(const Contexto &contexto, std::ostream &salida)
+{
+    BuscadorCaminos buscador;
+    const auto inicio = std::chrono::steady_clock::now();
+    const double largo = buscador.caminoMasCorto(contexto.csr, contexto.x, contexto.y, contexto.origen, contexto.destino);
+    const double tiempo = milisegundosDesde(inicio);
+    std::vector<int> camino;
+    buscador.camino(contexto.destino, camino);
+    salida << "{\"origen\":" << contexto.origen << ",\"destino\":" << contexto.destino << ",\"largo\":";
+    if (camino.empty()) {
+        salida << "null";
+    } else {
+        escribirReal(salida, largo);
+    }
+    salida << ",\"visitados\":" << buscador.verticesVisitados() << ",\"camino\":";
+    escribirArreglo(salida, camino);
+    salida << '}';
+    return tiempo;
+}
+
+double analizarTodosLosPares(const Contexto &contexto, std::ostream &salida)
+{
+    PoolHilos hilos; // Los hilos se crean antes de medir
+    const MetodoMatriz metodo = elegirMetodoMatriz(contexto.csr);
+    std::string error;
+    const auto inicio = std::chrono::steady_clock::now();
+    const bool escrita = exportarMatrizDistancias(contexto.csr, hilos, contexto.rutaMatriz, error, metodo);
+    const double tiempo = milisegundosDesde(inicio);
+    salida << "{\"archivo\":";
+    escribirCadena(salida, contexto.rutaMatriz);
+    salida << ",\"metodo\":\"" << (metodo == MetodoMatriz::FloydWarshall ? "floyd-warshall" : "bfs") << '"'
+           << ",\"hilos\":" << hilos.cantidadHilos();
+    if (!escrita) {
+        salida << ",\"error\":";
+        escribirCadena(salida, error);
+    }
+    salida << '}';
+    return tiempo;
+}
+
+// Las cuatro variantes escriben lo mismo; con los empates resueltos por id dan las mismas aristas
+void escribirArbol(std::ostream &salida, const ArbolMinimo &arbol)
+{
+    salida << "{\"cantidad\":" << arbol.aristas.size() / 2 << ",\"largo\":";
+    escribirReal(salida, arbol.largo);
+    salida << ",\"aristas\":";
+    escribirArreglo(salida, arbol.aristas);
+    salida << '}';
+}
+
+double analizarArbolMinimo(const Contexto &contexto, std::ostream &salida)
+{
+    PoolHilos hilos;
+    const auto inicio = std::chrono::steady_clock::now();
+    const ArbolMinimo arbol = arbolMinimo(contexto.csr, contexto.x, contexto.y, hilos);
+    const double tiempo = milisegundosDesde(inicio);
+    escribirArbol(salida, arbol);
+    return tiempo;
+}
+
+double analizarKruskal(const Contexto &contexto, std::ostream &salida)
+{
+    const auto inicio = std::chrono::steady_clock::now();
+    const ArbolMinimo arbol = arbolKruskal(contexto.csr, contexto.x, contexto.y);
+    const double tiempo = milisegundosDesde(inicio);
+    escribirArbol(salida, arbol);
+    return tiempo;
+}
+
+double analizarPrim(const Contexto &contexto, std::ostream &salida)
+{
+    const auto inicio = std::chrono::steady_clock::now();
+    const ArbolMinimo arbol = arbolPrim(contexto.csr, contexto.x, contexto.y);
+    const double tiempo = milisegundosDesde(inicio);
+    escribirArbol(salida, arbol);
+    return tiempo;
+}
+
+double analizarBoruvka(const Contexto &contexto, std::ostream &salida)
+{
+    PoolHilos hilos;
+    const auto inicio = std::chrono::steady_clock::now();
+    const ArbolMinimo arbol = arbolBoruvka(contexto.csr, contexto.x, contexto.y, hilos);
+    const double tiempo = milisegundosDesde(inicio);
+    escribirArbol(salida, arbol);
+    return tiempo;
+}
+
+// Los tres coloreos escriben lo mismo, para poder compararlos en una sola ejecución
+void escribirColoreo(std::ostream &salida, int colores, const std::vector<int> &color)
+{
+    salida << "{\"cantidad\":" << colores << ",\"colores\":";
+    escribirArreglo(salida, color);
+    salida << '}';
+}
+
+double analizarColoreoVoraz(const Contexto &contexto, std::ostream &salida)
+{
+    std::vector<int> color;
+    const auto inicio = std::chrono::steady_clock::now();
+    const int colores = coloreoVoraz(contexto.csr, color);
+    const double tiempo = milisegundosDesde(inicio);
+    escribirColoreo(salida, colores, color);
+    return tiempo;
+}
+
+double analizarColoreoDSatur(const Contexto &contexto, std::ostream &salida)
+{
+    std::vector<int> color;
+    const auto inicio = std::chrono::steady_clock::now();
+    const int colores = coloreoDSatur(contexto.csr, color);
+    const double tiempo = milisegundosDesde(inicio);
+    escribirColoreo(salida, colores, color);
+    return tiempo;
+}
+
+double analizarColoreoParalelo(const Contexto &contexto, std::ostream &salida)
+{
+    PoolHilos hilos;
+    std::vector<int> color;
+    const auto inicio = std::chrono::steady_clock::now();
+    const int colores = coloreoParalelo(contexto.csr, hilos, color);
+    const double tiempo = milisegundosDesde(inicio);
+    escribirColoreo(salida, colores, color);
+    return tiempo;
+}
+
+// Escribe una clique o un conjunto independiente, y si la búsqueda fue exacta
+void escribirConjunto(std::ostream &salida, const ConjuntoMaximo &conjunto)
+{
+    salida << "{\"cantidad\":" << conjunto.vertices.size() << ",\"exacto\":" << (conjunto.exacto ? "true" : "false")
+           << ",\"vertices\":";
+    escribirArreglo(salida, conjunto.vertices);
+    salida << '}';
+}
+
+double analizarClique(const Contexto &contexto, std::ostream &salida)
+{
+    const auto inicio = std::chrono::steady_clock::now();
+    const ConjuntoMaximo clique = cliqueMaxima(contexto.csr, contexto.limiteNodos);
+    const double tiempo = milisegundosDesde(inicio);
+    escribirConjunto(salida, clique);
+    return tiempo;
+}
+
+double analizarIndependiente(const Contexto &contexto, std::ostream &salida)
+{
+    const auto inicio = std::chrono::steady_clock::now();
+    const ConjuntoMaximo independiente = conjuntoIndependienteMaximo(contexto.csr, contexto.limiteNodos);
+    const double tiempo = milisegundosDesde(inicio);
+    escribirConjunto(salida, independiente);
+    return tiempo;
+}
+
+struct Analisis {
+    const char *nombre;
+    double (*ejecutar)(const Contexto &, std::ostream &);
+};
+
+const Analisis analisisDisponibles[] = {
+    {"bfs", analizarAnchura},
+    {"dfs", analizarProfundidad},
+    {"components", analizarComponentes},
+    {"sssp", analizarDistancias},
+    {"path", analizarCamino},
+    {"apsp", analizarTodosLosPares},
+    {"mst", analizarArbolMinimo},
+    {"mst-kruskal", analizarKruskal},
+    {"mst-prim", analizarPrim},
+    {"mst-boruvka", analizarBoruvka},
+    {"color-greedy", analizarColoreoVoraz},
+    {"color-dsatur", analizarColoreoDSatur},
+    {"color-parallel", analizarColoreoParalelo},
+    {"clique", analizarClique},
+    {"independent-set", analizarIndependiente},
+};
+
+const Analisis *buscarAnalisis(const std::string &nombre)
+{
+    for (const Analisis &analisis : analisisDisponibles) {
+        if (nombre == analisis.nombre) {
+            return &analisis;
+        }
+    }
+    return nullptr;
+}
+
+// Lee un entero de la línea de comandos entre minimo y maximo; rechaza lo que no sea un número entero
+bool leerOpcionEntera(const char *texto, long long minimo, long long maximo, long long &valor)
+{
+    char *fin = nullptr;
+    errno = 0;
+    const long long leido = std::strtoll(texto, &fin, 10);
+    if (fin == texto || *fin != '\0' || errno == ERANGE || leido < minimo || leido > maximo) {
+        return false;
+    }
+    valor = leido;
+    return true;
+}
+
+void mostrarUso(const char *programa)
+{
+    std::cerr << "Uso: " << programa << " --batch entrada --run analisis[,analisis...]"
+              << " [--out salida.json] [--origen v] [--destino v]"
+              << " [--matriz distancias.dist] [--limite nodos] [--instrucciones avx2|sse2|escalar]\nAnálisis disponibles:";
+    for (const Analisis &analisis : analisisDisponibles) {
+        std::cerr << ' ' << analisis.nombre;
+    }
+    std::cerr << '\n';
+}
+
+} // namespace
+
+bool esModoLote(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--batch") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int ejecutarLote(int argc, char *argv[])
+{
+    std::ios::sync_with_stdio(false); // La salida estándar puede recibir arreglos muy grandes
+    std::string rutaEntrada, rutaSalida, listaAnalisis, rutaMatriz = "distancias.dist";
+    long long origen = 0, destino = 0;
+    long long limiteNodos = limiteNodosPorDefecto;
+    const long long maximoVertice = std::numeric_limits<int>::max();
+    for (int i = 1; i < argc; ++i) {
+        const std::string opcion = argv[i];
+        const bool tieneValor = i + 1 < argc;
+        if (opcion == "--batch" && tieneValor) {
+            rutaEntrada = argv[++i];
+        } else if (opcion == "--run" && tieneValor) {
+            listaAnalisis = argv[++i];
+        } else if (opcion == "--out" && tieneValor) {
+            rutaSalida = argv[++i];
+        } else if (opcion == "--origen" && tieneValor && leerOpcionEntera(argv[i + 1], 0, maximoVertice, origen)) {
+            ++i;
+        } else if (opcion == "--destino" && tieneValor && leerOpcionEntera(argv[i + 1], 0, maximoVertice, destino)) {
+            ++i;
+        } else if (opcion == "--matriz" && tieneValor) {
+            rutaMatriz = argv[++i];
+        } else if (opcion == "--limite" && tieneValor
+                   && leerOpcionEntera(argv[i + 1], 0, std::numeric_limits<long long>::max(), limiteNodos)) {
+            ++i;
+        } else if (opcion == "--instrucciones" && tieneValor && elegirInstrucciones(argv[i + 1])) {
+            ++i; // Antes de crear hilos, como pide elegirInstrucciones
+        } else {
+            if (tieneValor) {
+                std::cerr << "Opción o valor no válido: " << opcion << ' ' << argv[i + 1] << '\n';
+            }
+            mostrarUso(argv[0]);
+            return 2;
+        }
+    }
+    if (rutaEntrada.empty()) {
+        mostrarUso(argv[0]);
+        return 2;
+    }
+
+    // Se validan los análisis antes de cargar nada
+    std::vector<const Analisis *> pedidos;
+    std::stringstream nombres(listaAnalisis);
+    for (std::string nombre; std::getline(nombres, nombre, ',');) {
+        if (nombre.empty()) {
+            continue;
+        }
+        const Analisis *analisis = buscarAnalisis(nombre);
+        if (!analisis) {
+            std::cerr << "Análisis desconocido: " << nombre << '\n';
+            mostrarUso(argv[0]);
+            return 2;
+        }
+        pedidos.push_back(analisis);
+    }
+
+    // Un .grafo binario se mapea y se analiza sin copiarlo; el texto (propio,
+    // lista de aristas, DIMACS o GraphML) se interpreta a un Grafo y se usa su CSR
+    const auto inicioCarga = std::chrono::steady_clock::now();
+    Grafo grafo;
+    ArchivoGrafoBinario binario;
+    std::string error;
+    Contexto contexto{VistaCSR(), nullptr, nullptr, static_cast<int>(origen), static_cast<int>(destino), rutaMatriz, limiteNodos};
+    if (ArchivoGrafoBinario::esBinario(rutaEntrada)) {
+        if (!binario.abrir(rutaEntrada, error)) {
+            std::cerr << rutaEntrada << ": " << error << '\n';
+            return 1;
+        }
+        contexto.csr = binario.csr();
+        contexto.x = binario.posicionesX();
+        contexto.y = binario.posicionesY();
+    } else {
+        std::ifstream entrada(rutaEntrada, std::ios::binary);
+        if (!entrada) {
+            std::cerr << "No se pudo abrir " << rutaEntrada << '\n';
+            return 1;
+        }
+        FormatoImportacion formato;
+        const bool importado = formatoPorExtension(rutaEntrada, formato);
+        const bool cargado = importado ? importarGrafo(entrada, formato,
+                                                       [&grafo](LoteImportado &lote) { agregarLoteImportado(grafo, lote); },
+                                                       error)
+                                       : cargarGrafoTexto(entrada, grafo, error);
+        if (!cargado) {
+            std::cerr << rutaEntrada << ": " << error << '\n';
+            return 1;
+        }
+        contexto.csr = grafo.csr().vista();
+        contexto.x = grafo.posicionesX().data();
+        contexto.y = grafo.posicionesY().data();
+    }
+    const double tiempoCarga = milisegundosDesde(inicioCarga);
+
+    // El origen y el destino deben ser vértices del grafo; en uno vacío solo se acepta el 0 por defecto
+    const long long n = contexto.csr.n;
+    for (const long long vertice : {origen, destino}) {
+        if (vertice >= n && !(vertice == 0 && n == 0)) {
+            std::cerr << "El vértice " << vertice << " no existe; el grafo tiene " << n << " vértices\n";
+            mostrarUso(argv[0]);
+            return 2;
+        }
+    }
+
+    std::ofstream archivoSalida;
+    if (!rutaSalida.empty()) {
+        archivoSalida.open(rutaSalida);
+        if (!archivoSalida) {
+            std::cerr << "No se pudo crear " << rutaSalida << '\n';
+            return 1;
+        }
+    }
+    std::ostream &salida = rutaSalida.empty() ? std::cout : archivoSalida;
+    salida << std::fixed << std::setprecision(3); // Los tiempos en milisegundos; los resultados usan escribirReal
+
+    salida << "{\"entrada\":";
+    escribirCadena(salida, rutaEntrada);
+    salida << ",\"vertices\":" << contexto.csr.n << ",\"aristas\":" << contexto.csr.inicio[contexto.csr.n] / 2
+           << ",\"instrucciones\":\"" << instruccionesVectoriales() << '"' << ",\"tiempo_carga_ms\":" << tiempoCarga << ",\"analisis\":{";
+    for (size_t i = 0; i < pedidos.size(); ++i) {
+        if (i > 0) {
+            salida << ',';
+        }
+        salida << '"' << pedidos[i]->nombre << "\":{\"resultado\":";
+        const double tiempo = pedidos[i]->ejecutar(contexto, salida);
+        salida << ",\"tiempo_ms\":" << tiempo << '}';
+    }
+    salida << "}}\n";
+    salida.flush();
+    if (!salida) {
+        std::cerr << "Error al escribir el resultado\n";
+        return 1;
+    }
+    return 0;
+}
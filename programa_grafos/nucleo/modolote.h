@@ -0,0 +1,20 @@
+#ifndef MODOLOTE_H
+#define MODOLOTE_H
+
+// Modo por lotes, sin interfaz gráfica:
+//   prueba_2 --batch entrada.graph --run bfs,dfs,components,sssp,path,apsp,mst [--out resultado.json]
+//            [--origen v] [--destino v] [--matriz distancias.dist] [--limite nodos]
+//            [--instrucciones avx2|sse2|escalar]
+// apsp escribe la matriz de distancias en el archivo de --matriz (ver matrizdistancias.h);
+// --instrucciones fuerza una versión de los núcleos de vectorial.h, y el JSON dice cuál se usó
+// La entrada puede ser .graph, .grafo o cualquier formato importable (lista de
+// aristas, DIMACS, GraphML; ver importador.h). Carga el grafo, ejecuta los análisis pedidos en orden, escribe un JSON con
+// los resultados (en la salida estándar si no se da --out) y termina
+
+// Indica si los argumentos piden el modo por lotes
+bool esModoLote(int argc, char *argv[]);
+
+// Ejecuta el modo por lotes y devuelve el código de salida del programa
+int ejecutarLote(int argc, char *argv[]);
+
+#endif // MODOLOTE_H
@@ -0,0 +1,118 @@
+#include "pooladyacencia.h"
+
+#include <algorithm>
+
+int PoolAdyacencia::crearLista()
+{
+    bloques.emplace_back(); // Sin bloque hasta que reciba su primer valor
+    return cantidadListas() - 1;
+}
+
+void PoolAdyacencia::eliminarUltimaLista()
+{
+    if (bloques.empty()) {
+        return;
+    }
+    const Bloque &bloque = bloques.back();
+    if (bloque.clase >= 0) {
+        libres[bloque.clase].push_back(bloque.inicio); // El bloque queda para otro vértice
+    }
+    bloques.pop_back();
+}
+
+void PoolAdyacencia::reservarListas(size_t cantidad)
+{
+    bloques.reserve(cantidad);
+}
+
+void PoolAdyacencia::limpiar()
+{
+    // Todos son tipos triviales: vaciar los arreglos no recorre los elementos
+    memoria.clear();
+    bloques.clear();
+    for (std::vector<int> &clase : libres) {
+        clase.clear();
+    }
+}
+
+void PoolAdyacencia::agregar(int lista, int valor)
+{
+    Bloque &bloque = bloques[lista];
+    if (bloque.clase < 0 || bloque.tamano == capacidadDe(bloque.clase)) {
+        moverA(bloque, bloque.clase + 1); // Duplica la capacidad
+    }
+    memoria[bloque.inicio + bloque.tamano++] = valor;
+}
+
+bool PoolAdyacencia::quitar(int lista, int valor)
+{
+    Bloque &bloque = bloques[lista];
+    int *inicio = memoria.data() + bloque.inicio;
+    int *fin = inicio + bloque.tamano;
+    // Se busca desde el final: lo normal es deshacer lo último que se agregó
+    for (int *p = fin; p != inicio; --p) {
+        if (p[-1] == valor) {
+            std::copy(p, fin, p - 1);
+            --bloque.tamano;
+            return true;
+        }
+    }
+    return false;
+}
+
+int PoolAdyacencia::quitarUltimo(int lista)
+{
+    Bloque &bloque = bloques[lista];
+    return memoria[bloque.inicio + --bloque.tamano];
+}
+
+void PoolAdyacencia::reservar(int lista, int capacidad)
+{
+    Bloque &bloque = bloques[lista];
+    if (capacidad <= 0 || (bloque.clase >= 0 && capacidad <= capacidadDe(bloque.clase))) {
+        return;
+    }
+    int clase = std::max(bloque.clase, 0);
+    while (capacidadDe(clase) < capacidad) {
+        ++clase;
+    }
+    if (clase != bloque.clase) {
+        moverA(bloque, clase);
+    }
+}
+
+PoolAdyacencia::Lista PoolAdyacencia::lista(int lista) const
+{
+    const Bloque &bloque = bloques[lista];
+    if (bloque.clase < 0) {
+        return {nullptr, nullptr};
+    }
+    const int *inicio = memoria.data() + bloque.inicio;
+    return {inicio, inicio + bloque.tamano};
+}
+
+int PoolAdyacencia::tomarBloque(int clase)
+{
+    if (clase >= static_cast<int>(libres.size())) {
+        libres.resize(clase + 1);
+    }
+    if (!libres[clase].empty()) {
+        const int inicio = libres[clase].back(); // Reutiliza un bloque liberado
+        libres[clase].pop_back();
+        return inicio;
+    }
+    const int inicio = static_cast<int>(memoria.size());
+    memoria.resize(memoria.size() + capacidadDe(clase)); // Crece al final de la arena
+    return inicio;
+}
+
+void PoolAdyacencia::moverA(Bloque &bloque, int clase)
+{
+    const int nuevo = tomarBloque(clase); // Puede mover la arena, así que se copia después
+    if (bloque.clase >= 0) {
+        std::copy_n(memoria.begin() + bloque.inicio, bloque.tamano, memoria.begin() + nuevo);
+        libres[bloque.clase].push_back(bloque.inicio);
+    }
+    bloque.inicio = nuevo;
+    bloque.clase = clase;
+}
@@ -0,0 +1,55 @@
+#ifndef POOLADYACENCIA_H
+#define POOLADYACENCIA_H
+
+#include <cstddef>
+#include <vector>
+
+// Clase que guarda las listas de aristas de todos los vértices en un único
+// arreglo (arena). Cada lista ocupa un bloque de capacidad potencia de dos;
+// cuando crece o se elimina su vértice, el bloque va a una lista libre de su
+// tamaño para reutilizarse. Vaciar el pool no libera vértice por vértice
+class PoolAdyacencia {
+public:
+    // Vista de solo lectura de una lista; deja de ser válida si el pool cambia
+    struct Lista {
+        const int *inicio;
+        const int *fin;
+
+        const int *begin() const { return inicio; }
+        const int *end() const { return fin; }
+        size_t size() const { return static_cast<size_t>(fin - inicio); }
+        bool empty() const { return inicio == fin; }
+        int operator[](size_t i) const { return inicio[i]; }
+    };
+
+    int crearLista(); // Agrega una lista vacía y devuelve su índice
+    void eliminarUltimaLista(); // Quita la última lista y recicla su bloque
+    void reservarListas(size_t cantidad); // Prepara espacio para esa cantidad de listas
+    void limpiar(); // Vacía el pool en O(1) conservando la memoria reservada
+
+    void agregar(int lista, int valor); // Agrega un valor al final de la lista
+    bool quitar(int lista, int valor); // Quita la aparición más reciente del valor, sin cambiar el orden del resto
+    int quitarUltimo(int lista); // Quita y devuelve el último valor
+    void reservar(int lista, int capacidad); // Asegura capacidad sin cambiar el contenido
+
+    Lista lista(int lista) const;
+    int cantidadListas() const { return static_cast<int>(bloques.size()); }
+
+private:
+    // Ubicación de una lista dentro de la arena
+    struct Bloque {
+        int inicio = 0; // Primera casilla en memoria
+        int tamano = 0; // Valores guardados
+        int clase = -1; // Capacidad 2^(clase + 2); -1 si todavía no tiene bloque
+    };
+
+    static int capacidadDe(int clase) { return 4 << clase; }
+    int tomarBloque(int clase); // Devuelve el inicio de un bloque libre de esa clase
+    void moverA(Bloque &bloque, int clase); // Copia la lista a un bloque de otra clase
+
+    std::vector<int> memoria; // Arena con todos los bloques, uno tras otro
+    std::vector<Bloque> bloques; // Bloque de cada lista
+    std::vector<std::vector<int>> libres; // Inicios de bloques libres, por clase
+};
+
+#endif // POOLADYACENCIA_H
@@ -0,0 +1,83 @@
+#include "poolhilos.h"
+
+#include <algorithm>
+
+PoolHilos::PoolHilos(unsigned cantidad)
+{
+    for (unsigned i = 1; i < std::max(cantidad, 1u); ++i) {
+        hilos.emplace_back(&PoolHilos::trabajar, this);
+    }
+}
+
+PoolHilos::~PoolHilos()
+{
+    {
+        std::lock_guard<std::mutex> bloqueo(mutex);
+        detener = true;
+    }
+    hayTrabajo.notify_all();
+    for (std::thread &hilo : hilos) {
+        hilo.join();
+    }
+}
+
+void PoolHilos::paraCada(int n, const std::function<void(int, int)> &tareaNueva, int tamanoBloque)
+{
+    if (n <= 0) {
+        return;
+    }
+    // Varios bloques por hilo para equilibrar la carga cuando los índices cuestan distinto
+    const int porBloque = tamanoBloque > 0 ? tamanoBloque : std::max(1, n / static_cast<int>(8 * cantidadHilos()));
+    if (hilos.empty() || n <= porBloque) {
+        tareaNueva(0, n); // No vale la pena despertar a los hilos
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> bloqueo(mutex);
+        tarea = &tareaNueva;
+        total = n;
+        bloque = porBloque;
+        siguiente.store(0, std::memory_order_relaxed);
+        pendientes = static_cast<unsigned>(hilos.size());
+        ++ronda;
+    }
+    hayTrabajo.notify_all();
+    ejecutarBloques();
+
+    std::unique_lock<std::mutex> bloqueo(mutex);
+    terminado.wait(bloqueo, [this] { return pendientes == 0; });
+    tarea = nullptr;
+}
+
+void PoolHilos::trabajar()
+{
+    unsigned rondaVista = 0;
+    for (;;) {
+        std::unique_lock<std::mutex> bloqueo(mutex);
+        hayTrabajo.wait(bloqueo, [&] { return detener || ronda != rondaVista; });
+        if (detener) {
+            return;
+        }
+        rondaVista = ronda;
+        bloqueo.unlock();
+
+        ejecutarBloques();
+
+        bloqueo.lock();
+        if (--pendientes == 0) {
+            terminado.notify_one();
+        }
+    }
+}
+
+void PoolHilos::ejecutarBloques()
+{
+    for (;;) {
+        const int inicio = siguiente.fetch_add(bloque, std::memory_order_relaxed);
+        if (inicio >= total) {
+            return;
+        }
+        (*tarea)(inicio, std::min(total, inicio + bloque));
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef POOLHILOS_H
+#define POOLHILOS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Clase que mantiene hilos de trabajo creados una sola vez y reparte entre
+// ellos rangos de índices. El hilo que llama también trabaja, así que con
+// un solo núcleo no se crea ningún hilo adicional
+class PoolHilos {
+public:
+    // Usa tantos hilos como núcleos tenga la máquina, salvo que se indique otra cantidad
+    explicit PoolHilos(unsigned cantidad = std::thread::hardware_concurrency());
+    ~PoolHilos();
+    PoolHilos(const PoolHilos &) = delete;
+    PoolHilos &operator=(const PoolHilos &) = delete;
+
+    // Hilos que participan en cada llamada, incluido el que llama
+    unsigned cantidadHilos() const { return static_cast<unsigned>(hilos.size()) + 1; }
+
+    // Ejecuta tarea(inicio, fin) sobre bloques que cubren [0, n) y vuelve
+    // cuando terminaron todos. No debe llamarse desde dos hilos a la vez
+    void paraCada(int n, const std::function<void(int, int)> &tarea, int tamanoBloque = 0);
+
+private:
+    void trabajar(); // Bucle de cada hilo de trabajo
+    void ejecutarBloques(); // Toma bloques de la tarea actual hasta que no quedan
+
+    std::vector<std::thread> hilos;
+    std::mutex mutex;
+    std::condition_variable hayTrabajo; // Avisa a los hilos de una tarea nueva
+    std::condition_variable terminado; // Avisa al que llamó que todos terminaron
+    const std::function<void(int, int)> *tarea = nullptr; // Tarea de la ronda actual
+    int total = 0; // Tamaño del rango de la ronda actual
+    int bloque = 1; // Índices por bloque
+    std::atomic<int> siguiente{0}; // Inicio del próximo bloque sin tomar
+    unsigned pendientes = 0; // Hilos que aún no terminan la ronda
+    unsigned ronda = 0; // Cambia con cada llamada a paraCada
+    bool detener = false;
+};
+
+#endif // POOLHILOS_H
@@ -0,0 +1,312 @@
+#include "vectorial.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VECTORIAL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const double distanciaMinima2 = 1e-4; // Cuadrado de la menor distancia que se usa en la repulsión
+
+// Versiones escalares: sirven de respaldo y terminan los elementos sobrantes de las vectoriales
+
+// Revisa [inicio, n) partiendo del mejor candidato hallado hasta ahora
+int masCercanoDesde(const double *xs, const double *ys, int inicio, int n, double x, double y,
+                    int mejor, double mejorDistancia)
+{
+    for (int i = inicio; i < n; ++i) {
+        const double dx = xs[i] - x, dy = ys[i] - y;
+        const double d2 = dx * dx + dy * dy;
+        if (d2 < mejorDistancia || (d2 == mejorDistancia && (mejor < 0 || i < mejor))) {
+            mejorDistancia = d2;
+            mejor = i;
+        }
+    }
+    return mejor;
+}
+
+int masCercanoEscalar(const double *xs, const double *ys, int n, double x, double y, double radio)
+{
+    return masCercanoDesde(xs, ys, 0, n, x, y, -1, radio * radio);
+}
+
+void repulsionDesde(const double *xs, const double *ys, const double *masas, int inicio, int n, double x,
+                    double y, double k2, double &fx, double &fy)
+{
+    for (int i = inicio; i < n; ++i) {
+        const double dx = x - xs[i], dy = y - ys[i];
+        const double f = k2 * masas[i] / std::max(dx * dx + dy * dy, distanciaMinima2);
+        fx += dx * f;
+        fy += dy * f;
+    }
+}
+
+void repulsionEscalar(const double *xs, const double *ys, const double *masas, int n, double x, double y,
+                      double k2, double &fx, double &fy)
+{
+    repulsionDesde(xs, ys, masas, 0, n, x, y, k2, fx, fy);
+}
+
+// Cuenta los bits de una palabra sumando por grupos cada vez más anchos
+int contarBits(std::uint64_t palabra)
+{
+    palabra -= (palabra >> 1) & 0x5555555555555555ull;
+    palabra = (palabra & 0x3333333333333333ull) + ((palabra >> 2) & 0x3333333333333333ull);
+    palabra = (palabra + (palabra >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<int>((palabra * 0x0101010101010101ull) >> 56);
+}
+
+int contarComunesEscalar(const std::uint64_t *a, const std::uint64_t *b, int palabras)
+{
+    int total = 0;
+    for (int i = 0; i < palabras; ++i) {
+        total += contarBits(a[i] & b[i]);
+    }
+    return total;
+}
+
+#ifdef VECTORIAL_X86
+
+// El mejor de los carriles: menor distancia y, si empatan, menor índice
+int reducirCarriles(const double *distancias, const double *indices, int carriles, double &mejorDistancia)
+{
+    int mejor = -1;
+    for (int c = 0; c < carriles; ++c) {
+        const int i = static_cast<int>(indices[c]);
+        if (i >= 0 && (distancias[c] < mejorDistancia || (distancias[c] == mejorDistancia && (mejor < 0 || i < mejor)))) {
+            mejorDistancia = distancias[c];
+            mejor = i;
+        }
+    }
+    return mejor;
+}
+
+__attribute__((target("sse2"))) int masCercanoSse2(const double *xs, const double *ys, int n, double x,
+                                                     double y, double radio)
+{
+    const __m128d px = _mm_set1_pd(x), py = _mm_set1_pd(y);
+    __m128d mejorD = _mm_set1_pd(radio * radio);
+    __m128d mejorI = _mm_set1_pd(-1);
+    __m128d indice = _mm_set_pd(1, 0);
+    const __m128d paso = _mm_set1_pd(2);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d dx = _mm_sub_pd(_mm_loadu_pd(xs + i), px);
+        const __m128d dy = _mm_sub_pd(_mm_loadu_pd(ys + i), py);
+        const __m128d d2 = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        // Estrictamente menor, o igual al radio si el carril aún no tiene candidato
+        const __m128d sinCandidato = _mm_cmplt_pd(mejorI, _mm_setzero_pd());
+        const __m128d mascara = _mm_or_pd(_mm_cmplt_pd(d2, mejorD), _mm_and_pd(sinCandidato, _mm_cmple_pd(d2, mejorD)));
+        mejorD = _mm_or_pd(_mm_and_pd(mascara, d2), _mm_andnot_pd(mascara, mejorD));
+        mejorI = _mm_or_pd(_mm_and_pd(mascara, indice), _mm_andnot_pd(mascara, mejorI));
+        indice = _mm_add_pd(indice, paso);
+    }
+    alignas(16) double distancias[2], indices[2];
+    _mm_store_pd(distancias, mejorD);
+    _mm_store_pd(indices, mejorI);
+    double mejorDistancia = radio * radio;
+    const int mejor = reducirCarriles(distancias, indices, 2, mejorDistancia);
+    return masCercanoDesde(xs, ys, i, n, x, y, mejor, mejorDistancia);
+}
+
+__attribute__((target("sse2"))) void repulsionSse2(const double *xs, const double *ys, const double *masas,
+                                                     int n, double x, double y, double k2, double &fx,
+                                                     double &fy)
+{
+    const __m128d px = _mm_set1_pd(x), py = _mm_set1_pd(y), k = _mm_set1_pd(k2);
+    const __m128d minimo = _mm_set1_pd(distanciaMinima2);
+    __m128d sumaX = _mm_setzero_pd(), sumaY = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        const __m128d dx = _mm_sub_pd(px, _mm_loadu_pd(xs + i));
+        const __m128d dy = _mm_sub_pd(py, _mm_loadu_pd(ys + i));
+        const __m128d d2 = _mm_max_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), minimo);
+        const __m128d f = _mm_div_pd(_mm_mul_pd(k, _mm_loadu_pd(masas + i)), d2);
+        sumaX = _mm_add_pd(sumaX, _mm_mul_pd(dx, f));
+        sumaY = _mm_add_pd(sumaY, _mm_mul_pd(dy, f));
+    }
+    alignas(16) double parcialX[2], parcialY[2];
+    _mm_store_pd(parcialX, sumaX);
+    _mm_store_pd(parcialY, sumaY);
+    fx += parcialX[0] + parcialX[1];
+    fy += parcialY[0] + parcialY[1];
+    repulsionDesde(xs, ys, masas, i, n, x, y, k2, fx, fy);
+}
+
+__attribute__((target("avx2,fma"))) int masCercanoAvx2(const double *xs, const double *ys, int n, double x,
+                                                         double y, double radio)
+{
+    const __m256d px = _mm256_set1_pd(x), py = _mm256_set1_pd(y);
+    __m256d mejorD = _mm256_set1_pd(radio * radio);
+    __m256d mejorI = _mm256_set1_pd(-1);
+    __m256d indice = _mm256_set_pd(3, 2, 1, 0);
+    const __m256d paso = _mm256_set1_pd(4);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + i), px);
+        const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + i), py);
+        // Sin FMA: el redondeo tiene que ser el de la versión escalar para que los empates se resuelvan igual
+        const __m256d d2 = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        const __m256d sinCandidato = _mm256_cmp_pd(mejorI, _mm256_setzero_pd(), _CMP_LT_OQ);
+        const __m256d mascara = _mm256_or_pd(_mm256_cmp_pd(d2, mejorD, _CMP_LT_OQ),
+                                             _mm256_and_pd(sinCandidato, _mm256_cmp_pd(d2, mejorD, _CMP_LE_OQ)));
+        mejorD = _mm256_blendv_pd(mejorD, d2, mascara);
+        mejorI = _mm256_blendv_pd(mejorI, indice, mascara);
+        indice = _mm256_add_pd(indice, paso);
+    }
+    alignas(32) double distancias[4], indices[4];
+    _mm256_store_pd(distancias, mejorD);
+    _mm256_store_pd(indices, mejorI);
+    _mm256_zeroupper(); // El resto es código SSE: se evita la penalización por mezclar
+    double mejorDistancia = radio * radio;
+    const int mejor = reducirCarriles(distancias, indices, 4, mejorDistancia);
+    return masCercanoDesde(xs, ys, i, n, x, y, mejor, mejorDistancia);
+}
+
+__attribute__((target("avx2,fma"))) void repulsionAvx2(const double *xs, const double *ys, const double *masas,
+                                                         int n, double x, double y, double k2, double &fx,
+                                                         double &fy)
+{
+    const __m256d px = _mm256_set1_pd(x), py = _mm256_set1_pd(y), k = _mm256_set1_pd(k2);
+    const __m256d minimo = _mm256_set1_pd(distanciaMinima2);
+    __m256d sumaX = _mm256_setzero_pd(), sumaY = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m256d dx = _mm256_sub_pd(px, _mm256_loadu_pd(xs + i));
+        const __m256d dy = _mm256_sub_pd(py, _mm256_loadu_pd(ys + i));
+        const __m256d d2 = _mm256_max_pd(_mm256_fmadd_pd(dx, dx, _mm256_mul_pd(dy, dy)), minimo);
+        const __m256d f = _mm256_div_pd(_mm256_mul_pd(k, _mm256_loadu_pd(masas + i)), d2);
+        sumaX = _mm256_fmadd_pd(dx, f, sumaX);
+        sumaY = _mm256_fmadd_pd(dy, f, sumaY);
+    }
+    alignas(32) double parcialX[4], parcialY[4];
+    _mm256_store_pd(parcialX, sumaX);
+    _mm256_store_pd(parcialY, sumaY);
+    _mm256_zeroupper();
+    fx += (parcialX[0] + parcialX[1]) + (parcialX[2] + parcialX[3]);
+    fy += (parcialY[0] + parcialY[1]) + (parcialY[2] + parcialY[3]);
+    repulsionDesde(xs, ys, masas, i, n, x, y, k2, fx, fy);
+}
+
+// Con la instrucción POPCNT cada palabra se cuenta en un ciclo
+__attribute__((target("popcnt"))) int contarComunesPopcnt(const std::uint64_t *a, const std::uint64_t *b,
+                                                           int palabras)
+{
+    int total = 0;
+    for (int i = 0; i < palabras; ++i) {
+        total += static_cast<int>(__builtin_popcountll(a[i] & b[i]));
+    }
+    return total;
+}
+
+// Cuatro palabras por vuelta: cada mitad de byte se cuenta con una tabla de 16
+// entradas (vpshufb) y los conteos de bytes se suman por palabra con vpsadbw
+__attribute__((target("avx2,popcnt"))) int contarComunesAvx2(const std::uint64_t *a, const std::uint64_t *b,
+                                                              int palabras)
+{
+    const __m256i tabla = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i mitadBaja = _mm256_set1_epi8(0x0f);
+    __m256i acumulado = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= palabras; i += 4) {
+        const __m256i v = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)),
+                                           _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)));
+        const __m256i bajos = _mm256_shuffle_epi8(tabla, _mm256_and_si256(v, mitadBaja));
+        const __m256i altos = _mm256_shuffle_epi8(tabla, _mm256_and_si256(_mm256_srli_epi16(v, 4), mitadBaja));
+        acumulado = _mm256_add_epi64(acumulado, _mm256_sad_epu8(_mm256_add_epi8(bajos, altos), _mm256_setzero_si256()));
+    }
+    alignas(32) std::uint64_t parcial[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(parcial), acumulado);
+    int total = static_cast<int>(parcial[0] + parcial[1] + parcial[2] + parcial[3]);
+    for (; i < palabras; ++i) {
+        total += static_cast<int>(__builtin_popcountll(a[i] & b[i]));
+    }
+    return total;
+}
+
+#endif // VECTORIAL_X86
+
+// Tabla con la versión de cada núcleo que se usa en este procesador
+struct Nucleos {
+    int (*masCercano)(const double *, const double *, int, double, double, double);
+    void (*repulsion)(const double *, const double *, const double *, int, double, double, double, double &,
+                      double &);
+    int (*contarComunes)(const std::uint64_t *, const std::uint64_t *, int);
+    const char *nombre;
+};
+
+// Llena la tabla con la versión pedida; devuelve false si el procesador no la soporta
+bool nucleosDe(const std::string &nombre, Nucleos &salida)
+{
+    if (nombre == "escalar") {
+        salida = {masCercanoEscalar, repulsionEscalar, contarComunesEscalar, "escalar"};
+        return true;
+    }
+#ifdef VECTORIAL_X86
+    __builtin_cpu_init();
+    if (nombre == "avx2" && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        salida = {masCercanoAvx2, repulsionAvx2, contarComunesAvx2, "avx2"};
+        return true;
+    }
+    if (nombre == "sse2" && __builtin_cpu_supports("sse2")) {
+        // POPCNT llegó después que SSE2, así que se revisa aparte
+        salida = {masCercanoSse2, repulsionSse2,
+                  __builtin_cpu_supports("popcnt") ? contarComunesPopcnt : contarComunesEscalar, "sse2"};
+        return true;
+    }
+#endif
+    return false;
+}
+
+// La mejor versión que soporte el procesador; la escalar siempre está
+Nucleos elegirNucleos()
+{
+    Nucleos elegidos{};
+    for (const char *nombre : {"avx2", "sse2"}) {
+        if (nucleosDe(nombre, elegidos)) {
+            return elegidos;
+        }
+    }
+    nucleosDe("escalar", elegidos);
+    return elegidos;
+}
+
+Nucleos &nucleos()
+{
+    static Nucleos elegidos = elegirNucleos(); // Se detecta una sola vez, de forma segura entre hilos
+    return elegidos;
+}
+
+} // namespace
+
+int puntoMasCercano(const double *xs, const double *ys, int n, double x, double y, double radio)
+{
+    return nucleos().masCercano(xs, ys, n, x, y, radio);
+}
+
+void acumularRepulsion(const double *xs, const double *ys, const double *masas, int n, double x, double y,
+                       double k2, double &fx, double &fy)
+{
+    nucleos().repulsion(xs, ys, masas, n, x, y, k2, fx, fy);
+}
+
+int contarComunes(const std::uint64_t *a, const std::uint64_t *b, int palabras)
+{
+    return nucleos().contarComunes(a, b, palabras);
+}
+
+const char *instruccionesVectoriales()
+{
+    return nucleos().nombre;
+}
+
+bool elegirInstrucciones(const char *nombre)
+{
+    return nucleosDe(nombre, nucleos());
+}
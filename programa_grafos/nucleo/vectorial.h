@@ -0,0 +1,34 @@
+#ifndef VECTORIAL_H
+#define VECTORIAL_H
+
+#include <cstdint>
+
+// Núcleos de cálculo sobre arreglos contiguos de posiciones (x[] e y[] por
+// separado) y sobre conjuntos de bits. Cada función tiene una versión AVX2,
+// una SSE2 (o POPCNT) y una escalar; la primera llamada elige la mejor que
+// soporte el procesador. Fuera de x86 o con compiladores sin
+// __builtin_cpu_supports se usa siempre la escalar
+
+// Índice del punto más cercano a (x, y) a distancia <= radio, o -1 si no hay
+// ninguno. Si hay empate gana el menor índice
+int puntoMasCercano(const double *xs, const double *ys, int n, double x, double y, double radio);
+
+// Suma a (fx, fy) la repulsión que n fuentes ejercen sobre (x, y): cada una
+// aporta k2 * masa / d en la dirección que las aleja. Las distancias menores
+// que 0.01 se toman como 0.01, y una fuente en el mismo (x, y) no aporta nada
+void acumularRepulsion(const double *xs, const double *ys, const double *masas, int n, double x, double y,
+                       double k2, double &fx, double &fy);
+
+// Cantidad de bits en 1 de a[i] & b[i] para 0 <= i < palabras: el tamaño de
+// la intersección de dos conjuntos guardados como bitsets
+int contarComunes(const std::uint64_t *a, const std::uint64_t *b, int palabras);
+
+// Nombre de la versión elegida: "avx2", "sse2" o "escalar"
+const char *instruccionesVectoriales();
+
+// Fuerza una versión por nombre, para medir o comparar; devuelve false (y no
+// cambia nada) si el procesador no la soporta. Se llama antes de usar los
+// núcleos desde otros hilos
+bool elegirInstrucciones(const char *nombre);
+
+#endif // VECTORIAL_H
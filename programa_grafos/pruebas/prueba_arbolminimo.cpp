@@ -0,0 +1,72 @@
+// Kruskal, Prim y Borůvka deben devolver exactamente las mismas aristas, con
+// los empates de largo resueltos por id, en grafos al azar con y sin empates
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "arbolminimo.h"
+#include "grafo.h"
+#include "poolhilos.h"
+
+namespace {
+
+int fallos = 0;
+
+void comprobar(bool condicion, const char *descripcion, int caso)
+{
+    if (!condicion) {
+        std::printf("FALLA caso %d: %s\n", caso, descripcion);
+        ++fallos;
+    }
+}
+
+// Aristas como pares ordenados, para comparar sin depender del orden en que se agregaron
+std::vector<std::pair<int, int>> pares(const ArbolMinimo &arbol)
+{
+    std::vector<std::pair<int, int>> resultado;
+    for (size_t i = 0; i + 1 < arbol.aristas.size(); i += 2) {
+        resultado.emplace_back(arbol.aristas[i], arbol.aristas[i + 1]);
+    }
+    std::sort(resultado.begin(), resultado.end());
+    return resultado;
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 azar(22);
+    PoolHilos hilos;
+    for (int caso = 0; caso < 300; ++caso) {
+        const int n = 1 + static_cast<int>(azar() % 200);
+        const int aristas = static_cast<int>(azar() % (3 * n + 1));
+        // La mitad de los casos usa una rejilla chica: muchas aristas del mismo largo
+        const int rango = caso % 2 ? 1000000 : 8;
+        Grafo grafo;
+        for (int v = 0; v < n; ++v) {
+            grafo.agregarVertice(azar() % rango, azar() % rango);
+        }
+        for (int i = 0; i < aristas; ++i) {
+            const int a = static_cast<int>(azar() % n), b = static_cast<int>(azar() % n);
+            if (a != b) {
+                grafo.conectar(a, b);
+            }
+        }
+        const VistaCSR csr = grafo.csr().vista();
+        const double *xs = grafo.posicionesX().data(), *ys = grafo.posicionesY().data();
+
+        const ArbolMinimo kruskal = arbolKruskal(csr, xs, ys);
+        const ArbolMinimo prim = arbolPrim(csr, xs, ys);
+        const ArbolMinimo boruvka = arbolBoruvka(csr, xs, ys, hilos);
+        comprobar(pares(prim) == pares(kruskal), "Prim y Kruskal eligen aristas distintas", caso);
+        comprobar(pares(boruvka) == pares(kruskal), "Borůvka y Kruskal eligen aristas distintas", caso);
+        const double tolerancia = 1e-9 * std::max(1.0, kruskal.largo);
+        comprobar(std::abs(prim.largo - kruskal.largo) <= tolerancia, "Prim da otro largo total", caso);
+        comprobar(std::abs(boruvka.largo - kruskal.largo) <= tolerancia, "Borůvka da otro largo total", caso);
+    }
+    std::printf("%s: %d fallos\n", fallos ? "FALLA" : "OK", fallos);
+    return fallos ? 1 : 0;
+}
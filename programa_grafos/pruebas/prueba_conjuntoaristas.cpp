@@ -0,0 +1,65 @@
+// ConjuntoAristas contra std::set: inserciones, búsquedas y bajas al azar
+// sobre pocos vértices, para que haya muchas repeticiones y muchos
+// corrimientos hacia atrás al quitar
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <utility>
+
+#include "conjuntoaristas.h"
+
+namespace {
+
+int fallos = 0;
+
+void comprobar(bool condicion, const char *descripcion, int paso)
+{
+    if (!condicion) {
+        if (fallos < 10) {
+            std::printf("FALLA paso %d: %s\n", paso, descripcion);
+        }
+        ++fallos;
+    }
+}
+
+std::pair<int, int> normalizar(int a, int b)
+{
+    return {std::min(a, b), std::max(a, b)};
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 azar(8);
+    for (int vertices : {8, 64, 1000}) {
+        ConjuntoAristas conjunto;
+        std::set<std::pair<int, int>> esperado;
+        for (int paso = 0; paso < 200000; ++paso) {
+            const int a = static_cast<int>(azar() % vertices), b = static_cast<int>(azar() % vertices);
+            const int operacion = static_cast<int>(azar() % 10);
+            if (operacion < 5) {
+                // El orden de los extremos no importa: se inserta tal cual y se compara normalizado
+                comprobar(conjunto.insertar(a, b) == esperado.insert(normalizar(a, b)).second, "insertar", paso);
+            } else if (operacion < 8) {
+                comprobar(conjunto.quitar(b, a) == (esperado.erase(normalizar(a, b)) == 1), "quitar", paso);
+            } else {
+                comprobar(conjunto.contiene(a, b) == (esperado.count(normalizar(a, b)) == 1), "contiene", paso);
+            }
+            if (paso % 50000 == 49999) {
+                // Cada tanto se revisa todo y a veces se vacía, para probar también limpiar
+                for (const auto &arista : esperado) {
+                    comprobar(conjunto.contiene(arista.second, arista.first), "falta una arista", paso);
+                }
+                if (azar() % 2) {
+                    conjunto.limpiar();
+                    esperado.clear();
+                    comprobar(!conjunto.contiene(a, b), "quedó algo tras limpiar", paso);
+                }
+            }
+        }
+    }
+    std::printf("%s: %d fallos\n", fallos ? "FALLA" : "OK", fallos);
+    return fallos ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+// Importación por lotes: en GraphML un nodo nombrado por una arista antes de su
+// <node> debe quedar con la posición de su <data>, aunque el vértice ya se haya
+// entregado en un lote anterior; en una lista de aristas los ids pueden ser negativos
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+#include "grafo.h"
+#include "importador.h"
+
+namespace {
+
+int fallos = 0;
+
+void comprobar(bool condicion, const char *descripcion, int caso)
+{
+    if (!condicion) {
+        std::printf("FALLA caso %d: %s\n", caso, descripcion);
+        ++fallos;
+    }
+}
+
+// Importa el texto a un grafo vacío con lotes de tamanoLote elementos
+bool importar(const std::string &texto, FormatoImportacion formato, size_t tamanoLote, Grafo &grafo,
+              std::string &error)
+{
+    std::istringstream entrada(texto);
+    return importarGrafo(
+        entrada, formato, [&grafo](LoteImportado &lote) { agregarLoteImportado(grafo, lote); }, error, nullptr,
+        tamanoLote);
+}
+
+const char *const graphMLAristaPrimero = R"(<?xml version="1.0"?>
+<graphml>
+  <key id="d0" for="node" attr.name="x" attr.type="double"/>
+  <key id="d1" for="node" attr.name="y" attr.type="double"/>
+  <graph edgedefault="undirected">
+    <edge source="a" target="b"/>
+    <edge source="b" target="c"/>
+    <node id="c"><data key="d0">30.5</data><data key="d1">-4</data></node>
+    <node id="a"><data key="d0">10</data><data key="d1">20</data></node>
+    <node id="b"/>
+    <node id="a"><data key="d0">99</data><data key="d1">99</data></node>
+  </graph>
+</graphml>
+)";
+
+} // namespace
+
+int main()
+{
+    // Con lotes de un elemento los vértices ya se entregaron cuando aparece su <node>;
+    // con lotes grandes todavía están en el lote abierto
+    int caso = 0;
+    for (size_t tamanoLote : {size_t(1), size_t(2), size_t(65536)}) {
+        ++caso;
+        Grafo grafo;
+        std::string error;
+        const bool correcto = importar(graphMLAristaPrimero, FormatoImportacion::GraphML, tamanoLote, grafo, error);
+        comprobar(correcto, "GraphML válido rechazado", caso);
+        comprobar(grafo.cantidadVertices() == 3, "cantidad de vértices", caso);
+        comprobar(grafo.cantidadAristas() == 2, "cantidad de aristas", caso);
+        if (grafo.cantidadVertices() != 3) {
+            continue;
+        }
+        // Ids en orden de aparición: a = 0, b = 1, c = 2
+        comprobar(grafo.x(0) == 10 && grafo.y(0) == 20, "a toma la posición de su <node>, no la del repetido", caso);
+        comprobar(grafo.x(2) == 30.5 && grafo.y(2) == -4, "c toma la posición de su <node>", caso);
+        const PoolAdyacencia::Lista deA = grafo.aristasDe(0), deB = grafo.aristasDe(1);
+        comprobar(deA.size() == 1 && deA[0] == 1 && deB.size() == 1 && deB[0] == 2, "aristas a-b y b-c", caso);
+    }
+
+    // Lista de aristas con ids negativos
+    {
+        ++caso;
+        Grafo grafo;
+        std::string error;
+        const bool correcto = importar("-1 2\n2,-3\n# comentario\n-1 -3 0.5\n", FormatoImportacion::ListaAristas,
+                                       65536, grafo, error);
+        comprobar(correcto, "lista con ids negativos rechazada", caso);
+        comprobar(grafo.cantidadVertices() == 3, "tres ids distintos", caso);
+        comprobar(grafo.cantidadAristas() == 3, "tres aristas", caso);
+    }
+    for (const char *invalido : {"- 2\n", "1 -\n", "--1 2\n"}) {
+        ++caso;
+        Grafo grafo;
+        std::string error;
+        comprobar(!importar(invalido, FormatoImportacion::ListaAristas, 65536, grafo, error), "línea inválida aceptada",
+                  caso);
+    }
+
+    std::printf("%s: %d fallos\n", fallos ? "FALLA" : "OK", fallos);
+    return fallos ? 1 : 0;
+}
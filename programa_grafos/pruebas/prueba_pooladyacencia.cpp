@@ -0,0 +1,165 @@
+// PoolAdyacencia y Grafo contra modelos simples (vectores y std::set) con
+// altas, bajas y vaciados al azar. Conviene correrla también con
+// GRAFOS_SANITIZAR, que detecta bloques reciclados que se pisan
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "grafo.h"
+#include "pooladyacencia.h"
+
+namespace {
+
+int fallos = 0;
+
+void comprobar(bool condicion, const char *descripcion, int paso)
+{
+    if (!condicion) {
+        if (fallos < 10) {
+            std::printf("FALLA paso %d: %s\n", paso, descripcion);
+        }
+        ++fallos;
+    }
+}
+
+bool iguales(const PoolAdyacencia::Lista &lista, const std::vector<int> &esperada)
+{
+    return lista.size() == esperada.size() && std::equal(lista.begin(), lista.end(), esperada.begin());
+}
+
+void probarPool(std::mt19937 &azar)
+{
+    PoolAdyacencia pool;
+    std::vector<std::vector<int>> modelo;
+    for (int paso = 0; paso < 300000; ++paso) {
+        const int operacion = static_cast<int>(azar() % 100);
+        const int cantidad = static_cast<int>(modelo.size());
+        const int l = cantidad > 0 ? static_cast<int>(azar() % cantidad) : -1;
+        if (operacion < 8 || cantidad == 0) {
+            comprobar(pool.crearLista() == cantidad, "crearLista", paso);
+            modelo.emplace_back();
+        } else if (operacion < 12) {
+            pool.eliminarUltimaLista();
+            modelo.pop_back();
+        } else if (operacion < 60) {
+            const int valor = static_cast<int>(azar() % 50);
+            pool.agregar(l, valor);
+            modelo[l].push_back(valor);
+        } else if (operacion < 80) {
+            // Quita la aparición más reciente, sin cambiar el orden del resto
+            const int valor = static_cast<int>(azar() % 50);
+            auto it = std::find(modelo[l].rbegin(), modelo[l].rend(), valor);
+            const bool estaba = it != modelo[l].rend();
+            if (estaba) {
+                modelo[l].erase(std::next(it).base());
+            }
+            comprobar(pool.quitar(l, valor) == estaba, "quitar", paso);
+        } else if (operacion < 90) {
+            if (!modelo[l].empty()) {
+                comprobar(pool.quitarUltimo(l) == modelo[l].back(), "quitarUltimo", paso);
+                modelo[l].pop_back();
+            }
+        } else if (operacion < 99) {
+            pool.reservar(l, static_cast<int>(azar() % 200));
+        } else {
+            pool.limpiar();
+            modelo.clear();
+        }
+        if (l >= 0 && l < static_cast<int>(modelo.size())) {
+            comprobar(iguales(pool.lista(l), modelo[l]), "lista distinta", paso);
+        }
+        if (paso % 10000 == 0) {
+            // Un bloque reciclado mal pisaría otra lista: se revisan todas
+            comprobar(pool.cantidadListas() == static_cast<int>(modelo.size()), "cantidadListas", paso);
+            for (int i = 0; i < static_cast<int>(modelo.size()); ++i) {
+                comprobar(iguales(pool.lista(i), modelo[i]), "lista distinta en la revisión", paso);
+            }
+        }
+    }
+}
+
+void probarGrafo(std::mt19937 &azar)
+{
+    Grafo grafo;
+    std::set<std::pair<int, int>> modelo;
+    int vertices = 0;
+    for (int paso = 0; paso < 200000; ++paso) {
+        const int operacion = static_cast<int>(azar() % 100);
+        if (operacion < 10 || vertices < 2) {
+            comprobar(grafo.agregarVertice(paso, -paso) == vertices, "agregarVertice", paso);
+            ++vertices;
+        } else if (operacion < 14) {
+            // Con el vértice se van sus aristas
+            --vertices;
+            grafo.eliminarUltimoVertice();
+            for (auto it = modelo.begin(); it != modelo.end();) {
+                it = it->second == vertices ? modelo.erase(it) : std::next(it);
+            }
+        } else if (operacion < 99) {
+            const int a = static_cast<int>(azar() % vertices), b = static_cast<int>(azar() % vertices);
+            if (a == b) {
+                continue;
+            }
+            const std::pair<int, int> arista(std::min(a, b), std::max(a, b));
+            if (operacion < 70) {
+                comprobar(grafo.conectar(a, b) == modelo.insert(arista).second, "conectar", paso);
+            } else {
+                // Un lote como el de la ventana, que la mitad de las veces se deshace enseguida
+                const int c = static_cast<int>(azar() % vertices);
+                const Grafo::LoteAristas lote = grafo.conectarTodos({a, b, c});
+                std::vector<std::pair<int, int>> nuevas;
+                for (size_t i = 0; i < lote.vertices.size(); ++i) {
+                    const PoolAdyacencia::Lista lista = grafo.aristasDe(lote.vertices[i]);
+                    for (size_t k = lista.size() - lote.agregadas[i]; k < lista.size(); ++k) {
+                        nuevas.emplace_back(lote.vertices[i], lista[k]);
+                    }
+                }
+                for (const auto &nueva : nuevas) {
+                    comprobar(modelo.insert(nueva).second, "conectarTodos agregó una arista que ya estaba", paso);
+                }
+                if (operacion < 85) {
+                    grafo.deshacerLote(lote);
+                    for (const auto &nueva : nuevas) {
+                        modelo.erase(nueva);
+                    }
+                }
+            }
+        } else {
+            grafo.limpiar();
+            modelo.clear();
+            vertices = 0;
+        }
+        if (paso % 5000 == 0) {
+            comprobar(grafo.cantidadVertices() == vertices, "cantidadVertices", paso);
+            comprobar(grafo.cantidadAristas() == static_cast<int>(modelo.size()), "cantidadAristas", paso);
+            std::vector<int> grado(vertices, 0);
+            for (const auto &arista : modelo) {
+                ++grado[arista.first];
+                ++grado[arista.second];
+            }
+            const VistaCSR csr = grafo.csr().vista();
+            std::set<std::pair<int, int>> guardadas; // Cada arista está en la lista de su extremo menor
+            for (int v = 0; v < vertices; ++v) {
+                comprobar(grafo.grado(v) == grado[v] && csr.inicio[v + 1] - csr.inicio[v] == grado[v], "grado", paso);
+                for (int w : grafo.aristasDe(v)) {
+                    comprobar(v < w && guardadas.emplace(v, w).second, "arista fuera de lugar o repetida", paso);
+                }
+            }
+            comprobar(guardadas == modelo, "aristas", paso);
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 azar(11);
+    probarPool(azar);
+    probarGrafo(azar);
+    std::printf("%s: %d fallos\n", fallos ? "FALLA" : "OK", fallos);
+    return fallos ? 1 : 0;
+}
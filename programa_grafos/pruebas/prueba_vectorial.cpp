@@ -0,0 +1,106 @@
+// Cada versión vectorial de los núcleos (AVX2, SSE2/POPCNT) debe dar lo mismo
+// que la escalar: el mismo índice más cercano, empates incluidos, la misma
+// cantidad de bits comunes y la misma repulsión salvo el redondeo de la suma.
+// Los largos no son múltiplos del ancho del vector para probar los sobrantes
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "vectorial.h"
+
+namespace {
+
+int fallos = 0;
+
+void comprobar(bool condicion, const char *descripcion, const char *version, int caso)
+{
+    if (!condicion) {
+        std::printf("FALLA %s caso %d: %s\n", version, caso, descripcion);
+        ++fallos;
+    }
+}
+
+struct Resultados {
+    std::vector<int> cercanos;
+    std::vector<double> fuerzas; // fx, fy de cada caso
+    std::vector<int> comunes;
+};
+
+// Corre todos los casos con la versión elegida; el mismo azar da los mismos datos
+Resultados correr()
+{
+    Resultados resultados;
+    std::mt19937 azar(17);
+    std::uniform_real_distribution<double> coordenada(-100, 100);
+    std::uniform_int_distribution<int> entera(-4, 4);
+    for (int n = 0; n <= 37; ++n) {
+        for (int repeticion = 0; repeticion < 20; ++repeticion) {
+            // En la mitad de los casos las coordenadas son enteras chicas: hay
+            // muchos puntos a la misma distancia y puntos repetidos
+            const bool empates = repeticion % 2 == 0;
+            std::vector<double> xs(n), ys(n), masas(n);
+            for (int i = 0; i < n; ++i) {
+                xs[i] = empates ? entera(azar) : coordenada(azar);
+                ys[i] = empates ? entera(azar) : coordenada(azar);
+                masas[i] = 1 + (i % 3);
+            }
+            const double x = empates ? entera(azar) : coordenada(azar);
+            const double y = empates ? entera(azar) : coordenada(azar);
+            const double radio = empates ? 2 : 60; // Con enteros, 2 también prueba distancia igual al radio
+            resultados.cercanos.push_back(puntoMasCercano(xs.data(), ys.data(), n, x, y, radio));
+            double fx = 0.5, fy = -0.5; // La repulsión se suma a lo que ya había
+            acumularRepulsion(xs.data(), ys.data(), masas.data(), n, x, y, 3, fx, fy);
+            resultados.fuerzas.push_back(fx);
+            resultados.fuerzas.push_back(fy);
+        }
+    }
+    std::uniform_int_distribution<std::uint64_t> palabra;
+    for (int palabras = 0; palabras <= 21; ++palabras) {
+        for (int repeticion = 0; repeticion < 10; ++repeticion) {
+            std::vector<std::uint64_t> a(palabras), b(palabras);
+            for (int k = 0; k < palabras; ++k) {
+                a[k] = repeticion == 0 ? ~std::uint64_t(0) : palabra(azar);
+                b[k] = repeticion == 0 ? ~std::uint64_t(0) : palabra(azar);
+            }
+            resultados.comunes.push_back(contarComunes(a.data(), b.data(), palabras));
+        }
+    }
+    return resultados;
+}
+
+} // namespace
+
+int main()
+{
+    comprobar(elegirInstrucciones("escalar"), "la versión escalar no se pudo elegir", "escalar", 0);
+    const Resultados esperados = correr();
+    comprobar(!elegirInstrucciones("neon-inexistente"), "se aceptó una versión desconocida", "escalar", 0);
+
+    int probadas = 0;
+    for (const char *version : {"sse2", "avx2"}) {
+        if (!elegirInstrucciones(version)) {
+            std::printf("%s: no disponible en este procesador\n", version);
+            continue;
+        }
+        ++probadas;
+        const Resultados obtenidos = correr();
+        for (size_t i = 0; i < esperados.cercanos.size(); ++i) {
+            comprobar(obtenidos.cercanos[i] == esperados.cercanos[i], "puntoMasCercano distinto", version,
+                      static_cast<int>(i));
+        }
+        for (size_t i = 0; i < esperados.fuerzas.size(); ++i) {
+            const double diferencia = std::fabs(obtenidos.fuerzas[i] - esperados.fuerzas[i]);
+            comprobar(diferencia <= 1e-9 * (1 + std::fabs(esperados.fuerzas[i])), "acumularRepulsion distinta",
+                      version, static_cast<int>(i / 2));
+        }
+        for (size_t i = 0; i < esperados.comunes.size(); ++i) {
+            comprobar(obtenidos.comunes[i] == esperados.comunes[i], "contarComunes distinto", version,
+                      static_cast<int>(i));
+        }
+    }
+
+    std::printf("%s: %d fallos, %d versiones vectoriales comparadas\n", fallos ? "FALLA" : "OK", fallos, probadas);
+    return fallos ? 1 : 0;
+}